@@ -0,0 +1,231 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <exception>
+#include <filesystem>
+#include <cstdint>
+
+#include "benchmark.h"
+#include "day.h"
+#include "generators.h"
+#include "input.h"
+#include "registry.h"
+
+// Times the three phases of every selected day (parsing the input, part one and part two) separately.
+// Each repetition reloads the input and runs both parts in the same order as the standalone executables,
+// with the output of the days discarded. A few warmup repetitions are run (and thrown away) first, so that
+// the input is in the page cache and the allocator is warm.
+// With --size, the days are benchmarked on synthetic inputs of the given sizes (see generators.h) rather than
+// on the puzzle inputs, to measure how the solutions scale with the size of their input.
+
+struct Options {
+    bool is_test = false; 
+    size_t repetitions = 5; 
+    size_t warmup = 1; 
+    std::string json_file; 
+    std::string input_dir = AOC2022_INPUT_DIR; 
+    std::string input_file; 
+    std::vector<size_t> sizes;  // sizes of the generated inputs (none: use the puzzle inputs)
+    std::uint64_t seed = 0; 
+    std::vector<const aoc::Day*> days; 
+}; 
+
+struct DayResult {
+    const aoc::Day* day; 
+    std::string file_name; 
+    size_t size;  // size of the generated input, 0 for the puzzle inputs
+    size_t input_bytes; 
+    aoc::bench::Stats parse, part_one, part_two; 
+}; 
+
+void print_usage() {
+    std::cerr << "Usage: aoc2022_bench [test] [--repetitions N] [--warmup N] [--json FILE|-] [--input-dir DIR]\n"
+                 "                     [--input FILE] [--size N[,N...] [--seed S]] [DAY | FIRST-LAST ...]\n"
+                 "  test             benchmark the test cases (dayNN/test.txt) instead of the puzzle inputs\n"
+                 "  --repetitions N  number of timed repetitions of every day (default: 5)\n"
+                 "  --warmup N       number of untimed repetitions before the timed ones (default: 1)\n"
+                 "  --json FILE|-    also write the results as JSON to FILE (or to the standard output)\n"
+                 "  --input-dir DIR  directory containing the dayNN/ input directories\n"
+                 "  --input FILE     use FILE as the input of the (single) selected day\n"
+                 "  --size N[,N...]  benchmark on generated inputs of the given sizes (see aoc2022_generate)\n"
+                 "  --seed S         seed of the generated inputs (default: 0)\n"
+                 "  DAY, FIRST-LAST  days to benchmark (default: all the days)\n"
+                 "The options of the days (e.g. --top K for day 1, --scan for day 15) are passed on to them." << std::endl; 
+}
+
+bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]); 
+        bool has_value = i + 1 < argc; 
+
+        if (arg == "test") {
+            options.is_test = true; 
+        } else if (arg == "--repetitions" && has_value) {
+            options.repetitions = aoc::to_int<size_t>(argv[++i]); 
+            if (options.repetitions == 0) return false; 
+        } else if (arg == "--warmup" && has_value) {
+            options.warmup = aoc::to_int<size_t>(argv[++i]); 
+        } else if (arg == "--json" && has_value) {
+            options.json_file = argv[++i]; 
+        } else if (arg == "--input-dir" && has_value) {
+            options.input_dir = argv[++i]; 
+        } else if (arg == "--input" && has_value) {
+            options.input_file = argv[++i]; 
+        } else if (arg == "--size" && has_value) {
+            std::string_view sizes(argv[++i]); 
+            while (!sizes.empty()) {
+                auto size = aoc::to_int<size_t>(aoc::next_field(sizes, ',')); 
+                if (size == 0) return false; 
+                options.sizes.push_back(size); 
+            }
+        } else if (arg == "--seed" && has_value) {
+            options.seed = aoc::to_int<std::uint64_t>(argv[++i]); 
+        } else if (!aoc::select_days(arg, options.days)) {
+            return false; 
+        }
+    }
+
+    if (options.days.empty()) options.days = aoc::all_days(); 
+    // A custom input only makes sense for one day (and not together with generated ones), and the generated
+    // inputs are puzzle inputs, not test cases
+    if (!options.input_file.empty()) return options.days.size() == 1 && options.sizes.empty(); 
+    return options.sizes.empty() || !options.is_test; 
+}
+
+// Runs a day repetitions + warmup times, timing each phase of the timed repetitions
+DayResult benchmark_day(const aoc::Day& day, const std::string& file_name, size_t size, const Options& options) {
+    DayResult result{&day, file_name, size, aoc::InputFile(file_name).text().size(), {}, {}, {}}; 
+    std::vector<double> parse_ns, part_one_ns, part_two_ns; 
+
+    for (size_t r = 0; r < options.warmup + options.repetitions; ++r) {
+        double parse = aoc::bench::time_ns([&]() { day.load(file_name, options.is_test); }); 
+        double part_one = aoc::bench::time_ns(day.part_one); 
+        double part_two = aoc::bench::time_ns(day.part_two); 
+        if (r < options.warmup) continue; 
+        parse_ns.push_back(parse); 
+        part_one_ns.push_back(part_one); 
+        part_two_ns.push_back(part_two); 
+    }
+
+    result.parse = aoc::bench::summarize(parse_ns); 
+    result.part_one = aoc::bench::summarize(part_one_ns); 
+    result.part_two = aoc::bench::summarize(part_two_ns); 
+    return result; 
+}
+
+void print_table(const std::vector<DayResult>& results) {
+    auto ms = [](double ns) { return ns / 1e6; }; 
+    std::cout << "  day        size      bytes   parse (ms)  p99 (ms)   part 1 (ms)  p99 (ms)   part 2 (ms)  p99 (ms)   total (ms)\n"; 
+    std::cout << std::fixed << std::setprecision(3); 
+    double total = 0; 
+    for (const auto& r: results) {
+        double day_total = r.parse.median + r.part_one.median + r.part_two.median; 
+        total += day_total; 
+        std::cout << std::setw(5) << r.day->number << std::setw(12) << (r.size > 0 ? std::to_string(r.size) : "-") << std::setw(11) << r.input_bytes
+                  << std::setw(13) << ms(r.parse.median) << std::setw(10) << ms(r.parse.p99)
+                  << std::setw(14) << ms(r.part_one.median) << std::setw(10) << ms(r.part_one.p99)
+                  << std::setw(14) << ms(r.part_two.median) << std::setw(10) << ms(r.part_two.p99)
+                  << std::setw(13) << ms(day_total) << '\n'; 
+    }
+    std::cout << "  total (sum of the medians): " << ms(total) << " ms" << std::endl; 
+}
+
+void write_stats(std::ostream& os, const DayResult& r, const std::string& phase, const aoc::bench::Stats& s, bool is_last) {
+    os << "    {\"name\": "; 
+    auto name = "day" + std::to_string(r.day->number) + "/" + phase; 
+    if (r.size > 0) name += "/" + std::to_string(r.size); 
+    aoc::bench::write_json_string(os, name); 
+    os << ", \"day\": " << r.day->number << ", \"phase\": "; 
+    aoc::bench::write_json_string(os, phase); 
+    os << ", \"input\": "; 
+    aoc::bench::write_json_string(os, r.file_name); 
+    os << ", \"size\": " << r.size << ", \"input_bytes\": " << r.input_bytes << ", \"repetitions\": " << s.repetitions
+       << ", \"time_unit\": \"ns\", \"min\": " << s.min << ", \"median\": " << s.median
+       << ", \"p99\": " << s.p99 << ", \"mean\": " << s.mean << ", \"max\": " << s.max << "}"
+       << (is_last ? "\n" : ",\n"); 
+}
+
+// Same layout as the JSON output of Google Benchmark: a context object and a flat list of benchmarks
+void write_json(std::ostream& os, const std::vector<DayResult>& results, const Options& options) {
+    os << std::fixed << std::setprecision(0); 
+    os << "{\n  \"context\": {\"executable\": \"aoc2022_bench\", \"optimized_build\": "
+       << (aoc::bench::is_optimized_build() ? "true" : "false")
+       << ", \"test_inputs\": " << (options.is_test ? "true" : "false")
+       << ", \"seed\": " << options.seed << ", \"warmup\": " << options.warmup << ", \"repetitions\": " << options.repetitions << "},\n"
+       << "  \"benchmarks\": [\n"; 
+    for (size_t i = 0; i < results.size(); ++i) {
+        bool is_last = i + 1 == results.size(); 
+        write_stats(os, results.at(i), "parse", results.at(i).parse, false); 
+        write_stats(os, results.at(i), "part_one", results.at(i).part_one, false); 
+        write_stats(os, results.at(i), "part_two", results.at(i).part_two, is_last); 
+    }
+    os << "  ]\n}" << std::endl; 
+}
+
+int main(int argc, char* argv[]) {
+
+    // The options of the days are taken out of the command line first, whichever days are selected 
+    for (const auto* day: aoc::all_days()) aoc::take_day_options(*day, argc, argv); 
+
+    Options options; 
+    if (!parse_options(argc, argv, options)) {
+        print_usage(); 
+        return 1; 
+    }
+
+    if (!aoc::bench::is_optimized_build()) {
+        std::cerr << "Warning: the benchmarks were built without optimizations "
+                     "(configure with -DCMAKE_BUILD_TYPE=Release)" << std::endl; 
+    }
+
+    // The days print their answers, which would only add noise to the timings
+    std::ostream discard(nullptr); 
+    aoc::redirect_output(discard); 
+
+    std::vector<DayResult> results; 
+    auto run = [&](const aoc::Day& day, const std::string& file_name, size_t size) {
+        if (!aoc::InputFile(file_name).is_open()) {
+            std::cerr << "Could not open the file " << file_name << std::endl; 
+            return; 
+        }
+        try {
+            results.push_back(benchmark_day(day, file_name, size, options)); 
+        } catch (const std::exception& e) {
+            std::cerr << "Day " << day.number << " failed: " << e.what() << std::endl; 
+        }
+    }; 
+
+    if (options.sizes.empty()) {
+        for (auto day: options.days) {
+            run(*day, options.input_file.empty() ? aoc::input_file_name(options.input_dir, *day, options.is_test) : options.input_file, 0); 
+        }
+    }
+    for (auto size: options.sizes) {
+        for (auto day: options.days) {
+            auto file_name = (std::filesystem::temp_directory_path() / 
+                ("aoc2022_bench_day" + std::to_string(day->number) + "_" + std::to_string(size) + ".txt")).string(); 
+            {
+                std::ofstream input(file_name); 
+                aoc::bench::generate_input(*aoc::bench::find_generator(day->number), size, options.seed, input); 
+            }
+            run(*day, file_name, size); 
+            std::filesystem::remove(file_name); 
+        }
+    }
+
+    // When the JSON goes to the standard output, the table is left out so that the output can be parsed
+    if (options.json_file != "-") print_table(results); 
+    if (options.json_file == "-") {
+        write_json(std::cout, results, options); 
+    } else if (!options.json_file.empty()) {
+        std::ofstream json(options.json_file); 
+        if (!json.is_open()) {
+            std::cerr << "Could not open the file " << options.json_file << std::endl; 
+            return 1; 
+        }
+        write_json(json, results, options); 
+    }
+    return 0; 
+}
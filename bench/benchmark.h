@@ -0,0 +1,77 @@
+#ifndef AOC2022_BENCH_BENCHMARK_H
+#define AOC2022_BENCH_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Small self-contained timing helpers shared by the benchmark executables 
+
+namespace aoc {
+namespace bench {
+
+// Wall-clock time of a single call, in nanoseconds 
+template <typename Function> 
+double time_ns(Function&& function) {
+    auto start = std::chrono::steady_clock::now(); 
+    function(); 
+    auto end = std::chrono::steady_clock::now(); 
+    return std::chrono::duration<double, std::nano>(end - start).count(); 
+}
+
+// Summary of the timings of the repetitions of a benchmark (all in nanoseconds) 
+struct Stats {
+    size_t repetitions = 0; 
+    double min = 0, median = 0, p99 = 0, mean = 0, max = 0; 
+}; 
+
+// Nearest-rank percentile of sorted samples 
+inline double percentile(const std::vector<double>& sorted_samples, double p) {
+    if (sorted_samples.empty()) return 0; 
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted_samples.size())); 
+    return sorted_samples.at(std::max<size_t>(rank, 1) - 1); 
+}
+
+inline Stats summarize(std::vector<double> samples) {
+    Stats stats; 
+    if (samples.empty()) return stats; 
+    std::sort(samples.begin(), samples.end()); 
+    auto n = samples.size(); 
+    stats.repetitions = n; 
+    stats.min = samples.front(); 
+    stats.max = samples.back(); 
+    stats.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2; 
+    stats.p99 = percentile(samples, 99); 
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n; 
+    return stats; 
+}
+
+// Writes a string as a JSON string literal 
+inline void write_json_string(std::ostream& os, const std::string& s) {
+    os << '"'; 
+    for (auto c: s) {
+        if (c == '"' || c == '\\') os << '\\' << c; 
+        else if (c == '\n') os << "\\n"; 
+        else os << c; 
+    }
+    os << '"'; 
+}
+
+// True if the benchmarks were compiled with optimizations (timings of unoptimized builds are meaningless) 
+constexpr bool is_optimized_build() {
+#ifdef __OPTIMIZE__
+    return true; 
+#else
+    return false; 
+#endif
+}
+
+} // namespace bench
+} // namespace aoc
+
+#endif
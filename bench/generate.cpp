@@ -0,0 +1,58 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdint>
+
+#include "generators.h"
+#include "input.h"
+
+// Writes a synthetic input of any size for one day, e.g. 
+//   aoc2022_generate 20 1000000 --seed 7 -o day20_1M.txt
+
+void print_usage() {
+    std::cerr << "Usage: aoc2022_generate DAY SIZE [--seed S] [-o FILE]\n"
+                 "  DAY        day to generate the input of (1-25)\n"
+                 "  SIZE       size of the input, in the unit of the day (e.g. elves for day 1)\n"
+                 "  --seed S   seed of the random generator (default: 0)\n"
+                 "  -o FILE    write the input to FILE instead of the standard output" << std::endl; 
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 3) {
+        print_usage(); 
+        return 1; 
+    }
+
+    auto generator = aoc::bench::find_generator(aoc::to_int<int>(argv[1])); 
+    auto size = aoc::to_int<size_t>(argv[2]); 
+    std::uint64_t seed = 0; 
+    std::string output_file; 
+    for (int i = 3; i < argc; ++i) {
+        std::string arg(argv[i]); 
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = aoc::to_int<std::uint64_t>(argv[++i]); 
+        } else if (arg == "-o" && i + 1 < argc) {
+            output_file = argv[++i]; 
+        } else {
+            generator = nullptr; 
+        }
+    }
+    if (!generator) {
+        print_usage(); 
+        return 1; 
+    }
+
+    if (output_file.empty()) {
+        aoc::bench::generate_input(*generator, size, seed, std::cout); 
+        return 0; 
+    }
+    std::ofstream output(output_file); 
+    if (!output.is_open()) {
+        std::cerr << "Could not open the file " << output_file << std::endl; 
+        return 1; 
+    }
+    aoc::bench::generate_input(*generator, size, seed, output); 
+    std::cerr << "Day " << generator->day << ": " << size << " " << generator->size_unit << " written to " << output_file << std::endl; 
+    return 0; 
+}
@@ -0,0 +1,695 @@
+#include "generators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+namespace bench {
+
+namespace {
+
+// The standard distributions are implementation-defined, so the generators only use the raw engine output 
+// (which is fully specified) to give the same inputs on every platform. The modulo bias is negligible here. 
+long int uniform(std::mt19937_64& rng, long int lo, long int hi) {
+    return lo + static_cast<long int>(rng() % static_cast<std::uint64_t>(hi - lo + 1)); 
+}
+
+bool chance(std::mt19937_64& rng, double p) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53 < p; 
+}
+
+template <typename T>
+void shuffle(std::vector<T>& v, std::mt19937_64& rng) {
+    for (size_t i = v.size(); i > 1; --i) std::swap(v[i - 1], v[uniform(rng, 0, i - 1)]); 
+}
+
+template <typename T>
+const T& pick(const std::vector<T>& v, std::mt19937_64& rng) {
+    return v[uniform(rng, 0, v.size() - 1)]; 
+}
+
+const std::string LOWERCASE = "abcdefghijklmnopqrstuvwxyz"; 
+const std::string UPPERCASE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"; 
+
+// Name made of n_letters letters, unique for every index < 26^n_letters 
+std::string name_from_index(size_t index, size_t n_letters, const std::string& letters = LOWERCASE) {
+    std::string name(n_letters, letters[0]); 
+    for (size_t i = n_letters; i-- > 0; index /= letters.size()) name[i] = letters[index % letters.size()]; 
+    return name; 
+}
+
+// Day 1: blank-line separated groups of calories 
+void generate_day01(std::ostream& os, size_t n_elves, std::mt19937_64& rng) {
+    for (size_t i = 0; i < n_elves; ++i) {
+        if (i > 0) os << '\n'; 
+        for (auto n = uniform(rng, 1, 15); n > 0; --n) os << uniform(rng, 1000, 70000) << '\n'; 
+    }
+}
+
+// Day 2: "<A|B|C> <X|Y|Z>" rounds 
+void generate_day02(std::ostream& os, size_t n_rounds, std::mt19937_64& rng) {
+    for (size_t i = 0; i < n_rounds; ++i) {
+        os << static_cast<char>('A' + uniform(rng, 0, 2)) << ' ' << static_cast<char>('X' + uniform(rng, 0, 2)) << '\n'; 
+    }
+}
+
+// Day 3: rucksacks whose two halves share exactly one item, in groups of three sharing exactly one badge 
+void generate_day03(std::ostream& os, size_t n_rucksacks, std::mt19937_64& rng) {
+    const std::string items = LOWERCASE + UPPERCASE; 
+    for (size_t group = 0; group < (n_rucksacks + 2) / 3; ++group) {
+        char badge = items[uniform(rng, 0, items.size() - 1)]; 
+        // Every other item is missing from (at least) one of the three rucksacks 
+        std::vector<int> missing_from(items.size()); 
+        for (auto& m: missing_from) m = uniform(rng, 0, 2); 
+
+        for (int r = 0; r < 3; ++r) {
+            std::vector<char> allowed; 
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (items[i] != badge && missing_from[i] != r) allowed.push_back(items[i]); 
+            }
+            shuffle(allowed, rng); 
+            char shared = allowed.back(); 
+            allowed.pop_back(); 
+            // The halves draw their other items from disjoint pools 
+            std::vector<char> first_pool(allowed.begin(), allowed.begin() + allowed.size() / 2); 
+            std::vector<char> second_pool(allowed.begin() + allowed.size() / 2, allowed.end()); 
+
+            auto half_size = uniform(rng, 4, 16); 
+            std::vector<char> first_half{shared, badge}, second_half{shared}; 
+            while (static_cast<long int>(first_half.size()) < half_size) first_half.push_back(pick(first_pool, rng)); 
+            while (static_cast<long int>(second_half.size()) < half_size) second_half.push_back(pick(second_pool, rng)); 
+            shuffle(first_half, rng); 
+            shuffle(second_half, rng); 
+            os << std::string(first_half.begin(), first_half.end()) << std::string(second_half.begin(), second_half.end()) << '\n'; 
+        }
+    }
+}
+
+// Day 4: "a-b,c-d" pairs of section ranges 
+void generate_day04(std::ostream& os, size_t n_pairs, std::mt19937_64& rng) {
+    for (size_t i = 0; i < n_pairs; ++i) {
+        for (int elf = 0; elf < 2; ++elf) {
+            auto a = uniform(rng, 1, 99), b = uniform(rng, 1, 99); 
+            os << std::min(a, b) << '-' << std::max(a, b) << (elf == 0 ? ',' : '\n'); 
+        }
+    }
+}
+
+// Day 5: drawing of nine stacks of crates, followed by moves which never empty a stack (the answers are 
+// made of the crates on top of every stack) 
+void generate_day05(std::ostream& os, size_t n_moves, std::mt19937_64& rng) {
+    const size_t n_stacks = 9; 
+    std::vector<std::string> stacks(n_stacks); 
+    size_t max_height = 0; 
+    for (size_t i = 0; i < n_stacks; ++i) {
+        // At least one stack has two crates, so there is always a crate which can be moved 
+        for (auto n = uniform(rng, i == 0 ? 2 : 1, 8); n > 0; --n) stacks[i] += UPPERCASE[uniform(rng, 0, 25)]; 
+        max_height = std::max(max_height, stacks[i].size()); 
+    }
+
+    for (size_t row = max_height; row-- > 0;) {
+        for (size_t i = 0; i < n_stacks; ++i) {
+            os << (row < stacks[i].size() ? std::string{'[', stacks[i][row], ']'} : "   ") << (i + 1 < n_stacks ? " " : "\n"); 
+        }
+    }
+    for (size_t i = 0; i < n_stacks; ++i) os << ' ' << i + 1 << ' ' << (i + 1 < n_stacks ? " " : "\n"); 
+    os << '\n'; 
+
+    std::vector<size_t> heights; 
+    for (const auto& s: stacks) heights.push_back(s.size()); 
+    for (size_t i = 0; i < n_moves; ++i) {
+        size_t from; 
+        do { from = uniform(rng, 0, n_stacks - 1); } while (heights[from] < 2); 
+        size_t to = (from + uniform(rng, 1, n_stacks - 1)) % n_stacks; 
+        size_t size = uniform(rng, 1, std::min<size_t>(heights[from] - 1, 10)); 
+        heights[from] -= size; 
+        heights[to] += size; 
+        os << "move " << size << " from " << from + 1 << " to " << to + 1 << '\n'; 
+    }
+}
+
+// Day 6: a datastream whose start-of-packet and start-of-message markers are both at its very end 
+void generate_day06(std::ostream& os, size_t n_characters, std::mt19937_64& rng) {
+    const std::string marker = "defghijklmnopq"; 
+    // Three letters can never make a marker 
+    for (size_t i = marker.size(); i < n_characters; ++i) os << static_cast<char>('a' + uniform(rng, 0, 2)); 
+    os << marker << '\n'; 
+}
+
+// Day 7: terminal session exploring a random directory tree, using 45 to 65 MB of the 70 MB disk 
+void generate_day07(std::ostream& os, size_t n_directories, std::mt19937_64& rng) {
+    n_directories = std::max<size_t>(n_directories, 1); 
+    std::vector<std::vector<size_t>> subdirectories(n_directories); 
+    std::vector<size_t> n_files(n_directories); 
+    size_t total_files = 0; 
+    for (size_t i = 0; i < n_directories; ++i) {
+        if (i > 0) subdirectories[uniform(rng, 0, i - 1)].push_back(i); 
+        n_files[i] = uniform(rng, 0, 4); 
+        total_files += n_files[i]; 
+    }
+    long int mean_file_size = uniform(rng, 45000000, 65000000) / std::max<size_t>(total_files, 1); 
+
+    // Depth-first walk through the tree, listing every directory when entering it 
+    std::vector<std::pair<size_t, size_t>> path{{0, 0}};  // (directory, next subdirectory to enter)
+    os << "$ cd /\n"; 
+    while (!path.empty()) {
+        auto& current = path.back(); 
+        auto directory = current.first; 
+        if (current.second == 0) {
+            os << "$ ls\n"; 
+            for (auto s: subdirectories[directory]) os << "dir " << name_from_index(s, 4) << '\n'; 
+            for (size_t f = 0; f < n_files[directory]; ++f) {
+                os << uniform(rng, mean_file_size / 10 + 1, mean_file_size * 19 / 10 + 1) << ' ' << name_from_index(f, 3) << ".txt\n"; 
+            }
+        }
+        if (current.second < subdirectories[directory].size()) {
+            auto s = subdirectories[directory][current.second++]; 
+            os << "$ cd " << name_from_index(s, 4) << '\n'; 
+            path.emplace_back(s, 0); 
+        } else {
+            path.pop_back(); 
+            if (!path.empty()) os << "$ cd ..\n"; 
+        }
+    }
+}
+
+// Day 8: square grid of tree heights 
+void generate_day08(std::ostream& os, size_t side, std::mt19937_64& rng) {
+    for (size_t row = 0; row < side; ++row) {
+        for (size_t col = 0; col < side; ++col) os << static_cast<char>('0' + uniform(rng, 0, 9)); 
+        os << '\n'; 
+    }
+}
+
+// Day 9: "<U|D|L|R> <steps>" head motions 
+void generate_day09(std::ostream& os, size_t n_motions, std::mt19937_64& rng) {
+    const std::string directions = "UDLR"; 
+    for (size_t i = 0; i < n_motions; ++i) os << directions[uniform(rng, 0, 3)] << ' ' << uniform(rng, 1, 20) << '\n'; 
+}
+
+// Day 10: noop/addx program keeping the register within the 40 columns of the screen 
+void generate_day10(std::ostream& os, size_t n_instructions, std::mt19937_64& rng) {
+    long int x = 1; 
+    for (size_t i = 0; i < n_instructions; ++i) {
+        if (chance(rng, 0.3)) {
+            os << "noop\n"; 
+            continue; 
+        }
+        auto v = uniform(rng, -10, 10); 
+        if (x + v < 0 || x + v > 39) v = -v; 
+        x += v; 
+        os << "addx " << v << '\n'; 
+    }
+}
+
+// Day 11: the usual eight monkeys (with the prime divisors 2..19, whose product keeps old * old within 
+// 64 bits in part two), holding the given number of items in total. Part one keeps the exact worry levels, 
+// and an item which keeps coming back to the squaring monkey soon outgrows 64 bits, so the items only get 
+// starting levels (and monkeys) whose 20 rounds of part one stay within 64 bits 
+struct Monkey {
+    bool is_square, is_multiply; 
+    std::uint64_t operand, divisor; 
+    size_t if_true, if_false; 
+}; 
+
+// Plays the 20 rounds of part one for a single item, as day 11 does; returns false if a worry level 
+// does not fit in 64 bits 
+bool fits_in_64_bits(const std::vector<Monkey>& monkeys, size_t monkey, std::uint64_t worry_level) {
+    for (int round = 0; round < 20; ++round) {
+        size_t next_monkey; 
+        do {
+            const auto& m = monkeys[monkey]; 
+            auto operand = m.is_square ? worry_level : m.operand; 
+            bool overflows = m.is_square || m.is_multiply ? __builtin_mul_overflow(worry_level, operand, &worry_level) 
+                                                          : __builtin_add_overflow(worry_level, operand, &worry_level); 
+            if (overflows) return false; 
+            worry_level /= 3; 
+            next_monkey = worry_level % m.divisor == 0 ? m.if_true : m.if_false; 
+            std::swap(monkey, next_monkey); 
+        } while (monkey > next_monkey);  // thrown to a later monkey: inspected again in the same round 
+    }
+    return true; 
+}
+
+void check_day11(const std::vector<Monkey>& monkeys, const std::vector<std::vector<std::uint64_t>>& items) {
+    for (size_t m = 0; m < items.size(); ++m) {
+        for (auto worry_level: items[m]) {
+            if (!fits_in_64_bits(monkeys, m, worry_level)) {
+                throw std::logic_error("Day 11: a generated item outgrows 64 bits in part one"); 
+            }
+        }
+    }
+}
+
+void generate_day11(std::ostream& os, size_t n_items, std::mt19937_64& rng) {
+    const size_t n_monkeys = 8; 
+    std::vector<Monkey> monkeys; 
+    std::vector<std::pair<size_t, std::uint64_t>> starts;  // the (monkey, worry level) which fit in 64 bits 
+    // The monkeys are drawn again until at least half of them can start with some items 
+    for (size_t n_starting_monkeys = 0; n_starting_monkeys < n_monkeys / 2;) {
+        std::vector<std::uint64_t> divisors{2, 3, 5, 7, 11, 13, 17, 19}; 
+        shuffle(divisors, rng); 
+        auto squaring_monkey = static_cast<size_t>(uniform(rng, 0, n_monkeys - 1)); 
+        monkeys.clear(); 
+        for (size_t m = 0; m < n_monkeys; ++m) {
+            Monkey monkey{m == squaring_monkey, chance(rng, 0.5), 0, divisors[m], 0, 0}; 
+            if (!monkey.is_square) monkey.operand = monkey.is_multiply ? uniform(rng, 2, 19) : uniform(rng, 1, 8); 
+            monkey.if_true = (m + uniform(rng, 1, n_monkeys - 1)) % n_monkeys; 
+            do { monkey.if_false = (m + uniform(rng, 1, n_monkeys - 1)) % n_monkeys; } while (monkey.if_false == monkey.if_true); 
+            monkeys.push_back(monkey); 
+        }
+        starts.clear(); 
+        n_starting_monkeys = 0; 
+        for (size_t m = 0; m < n_monkeys; ++m) {
+            auto n_starts = starts.size(); 
+            for (std::uint64_t worry_level = 50; worry_level <= 99; ++worry_level) {
+                if (fits_in_64_bits(monkeys, m, worry_level)) starts.emplace_back(m, worry_level); 
+            }
+            if (starts.size() > n_starts) ++n_starting_monkeys; 
+        }
+    }
+
+    std::vector<std::vector<std::uint64_t>> items(n_monkeys); 
+    for (size_t i = 0; i < n_items; ++i) {
+        const auto& start = pick(starts, rng); 
+        items[start.first].push_back(start.second); 
+    }
+    check_day11(monkeys, items); 
+
+    for (size_t m = 0; m < n_monkeys; ++m) {
+        const auto& monkey = monkeys[m]; 
+        if (m > 0) os << '\n'; 
+        os << "Monkey " << m << ":\n  Starting items: "; 
+        for (size_t i = 0; i < items[m].size(); ++i) os << (i > 0 ? ", " : "") << items[m][i]; 
+        os << "\n  Operation: new = old "; 
+        if (monkey.is_square) os << "* old"; 
+        else os << (monkey.is_multiply ? "* " : "+ ") << monkey.operand; 
+        os << "\n  Test: divisible by " << monkey.divisor << "\n    If true: throw to monkey " << monkey.if_true
+           << "\n    If false: throw to monkey " << monkey.if_false << '\n'; 
+    }
+}
+
+// Day 12: square heightmap (at least 30x30, enough to climb from 'a' to 'z') rising towards E, with random 
+// dips; S is an 'a' square from which E can be reached 
+void generate_day12(std::ostream& os, size_t side, std::mt19937_64& rng) {
+    side = std::max<size_t>(side, 30); 
+    const long int n = side; 
+    const long int end_row = uniform(rng, n / 4, n - 1 - n / 4), end_col = uniform(rng, n / 4, n - 1 - n / 4); 
+    const long int step = std::max<long int>(1, n / 26); 
+
+    for (bool with_dips: {true, false}) {
+        std::vector<std::string> grid(side, std::string(side, 'a')); 
+        for (long int r = 0; r < n; ++r) {
+            for (long int c = 0; c < n; ++c) {
+                // The squares next to E are all 'z', as E can only be entered from a 'z' square 
+                auto distance = std::max<long int>(0, std::abs(r - end_row) + std::abs(c - end_col) - 1); 
+                auto height = std::max<long int>(0, 25 - distance / step); 
+                if (with_dips && distance > 0 && height > 0 && chance(rng, 0.2)) --height; 
+                grid[r][c] = static_cast<char>('a' + height); 
+            }
+        }
+        grid[end_row][end_col] = 'z'; 
+
+        // Reverse breadth-first search from E: a square is reached if it can climb to an already reached neighbor 
+        std::vector<bool> reached(side * side, false); 
+        std::queue<long int> q; 
+        q.push(end_row * n + end_col); 
+        reached[end_row * n + end_col] = true; 
+        std::vector<long int> candidates; 
+        while (!q.empty()) {
+            auto square = q.front(); 
+            q.pop(); 
+            long int r = square / n, c = square % n; 
+            if (grid[r][c] == 'a') candidates.push_back(square); 
+            const long int neighbors[4][2] = {{r - 1, c}, {r + 1, c}, {r, c - 1}, {r, c + 1}}; 
+            for (const auto& nb: neighbors) {
+                if (nb[0] < 0 || nb[0] >= n || nb[1] < 0 || nb[1] >= n) continue; 
+                auto next = nb[0] * n + nb[1]; 
+                // E can only be entered from a 'z' square 
+                auto lowest = square == end_row * n + end_col ? 'z' : grid[r][c] - 1; 
+                if (reached[next] || grid[nb[0]][nb[1]] < lowest) continue; 
+                reached[next] = true; 
+                q.push(next); 
+            }
+        }
+        // Without the dips every square can reach E, so the second attempt always has a start 
+        if (candidates.empty()) continue; 
+
+        auto start = pick(candidates, rng); 
+        grid[start / n][start % n] = 'S'; 
+        grid[end_row][end_col] = 'E'; 
+        for (const auto& row: grid) os << row << '\n'; 
+        return; 
+    }
+}
+
+void generate_packet(std::ostream& os, std::mt19937_64& rng, int depth) {
+    os << '['; 
+    for (auto n = uniform(rng, 0, 4), i = 0L; i < n; ++i) {
+        if (i > 0) os << ','; 
+        if (depth < 4 && chance(rng, 0.3)) generate_packet(os, rng, depth + 1); 
+        else os << uniform(rng, 0, 10); 
+    }
+    os << ']'; 
+}
+
+// Day 13: blank-line separated pairs of nested packets 
+void generate_day13(std::ostream& os, size_t n_pairs, std::mt19937_64& rng) {
+    for (size_t i = 0; i < n_pairs; ++i) {
+        if (i > 0) os << '\n'; 
+        for (int p = 0; p < 2; ++p) {
+            generate_packet(os, rng, 0); 
+            os << '\n'; 
+        }
+    }
+}
+
+// Day 14: axis-aligned rock paths around the sand source (500,0); the cave gets deeper as the number 
+// of paths grows (about as deep as the puzzle input for ~150 paths) 
+void generate_day14(std::ostream& os, size_t n_paths, std::mt19937_64& rng) {
+    const long int depth = 20 + static_cast<long int>(10 * std::sqrt(static_cast<double>(n_paths))); 
+    for (size_t i = 0; i < n_paths; ++i) {
+        long int x = uniform(rng, 500 - depth / 2, 500 + depth / 2), y = uniform(rng, 5, depth); 
+        os << x << ',' << y; 
+        bool is_horizontal = chance(rng, 0.5); 
+        for (auto n = uniform(rng, 1, 5); n > 0; --n, is_horizontal = !is_horizontal) {
+            auto length = uniform(rng, -10, 10); 
+            if (is_horizontal) x = std::max<long int>(1, x + length); 
+            else y = std::min(depth, std::max<long int>(1, y + length)); 
+            os << " -> " << x << ',' << y; 
+        }
+        os << '\n'; 
+    }
+}
+
+// Day 15: sensors on a jittered lattice covering the 4000000x4000000 search area, each one with its beacon 
+// as far as possible without reaching the distress beacon, which is therefore never covered. Four more sensors 
+// frame the distress beacon: they sit on its diagonals, far enough to cover the whole area, with their beacons 
+// on its four neighbours, so that their ranges touch around it and it is the only cell left uncovered 
+struct Sensor {
+    long int x, y, range; 
+}; 
+
+// Checks that the sensors leave exactly one uncovered cell in the search area, at (hole_x, hole_y), so that every 
+// way of searching for the distress beacon finds the same one. In the rotated coordinates u = x + y, v = x - y, the 
+// range of a sensor is a square, and the area lies in [0, 2 * area] x [-area, area]: no sensor may reach the hole, 
+// and the four boxes around it (u < hole, u > hole, then v < hole and v > hole on the hole's own diagonal) must each 
+// be covered by a single sensor 
+void check_day15(const std::vector<Sensor>& sensors, long int area, long int hole_x, long int hole_y) {
+    const long int hole_u = hole_x + hole_y, hole_v = hole_x - hole_y; 
+    auto covers = [](const Sensor& s, long int u_min, long int u_max, long int v_min, long int v_max) {
+        const long int u = s.x + s.y, v = s.x - s.y; 
+        return u - s.range <= u_min && u_max <= u + s.range && v - s.range <= v_min && v_max <= v + s.range; 
+    }; 
+    auto is_covered = [&](long int u_min, long int u_max, long int v_min, long int v_max) {
+        if (u_min > u_max || v_min > v_max) return true; 
+        return std::any_of(sensors.begin(), sensors.end(), [&](const Sensor& s) { return covers(s, u_min, u_max, v_min, v_max); }); 
+    }; 
+
+    bool is_hole_reached = std::any_of(sensors.begin(), sensors.end(), [&](const Sensor& s) { 
+        return covers(s, hole_u, hole_u, hole_v, hole_v); 
+    }); 
+    if (is_hole_reached || !is_covered(0, hole_u - 1, -area, area) || !is_covered(hole_u + 1, 2 * area, -area, area) || 
+        !is_covered(hole_u, hole_u, -area, hole_v - 1) || !is_covered(hole_u, hole_u, hole_v + 1, area)) {
+        throw std::logic_error("Day 15: the generated sensors do not leave a single uncovered cell"); 
+    }
+}
+
+void generate_day15(std::ostream& os, size_t n_sensors, std::mt19937_64& rng) {
+    const long int area = 4000000; 
+    const long int hole_x = uniform(rng, 0, area), hole_y = uniform(rng, 0, area); 
+    const size_t n_lattice_sensors = n_sensors > 4 ? n_sensors - 4 : 0; 
+    auto per_side = std::max<long int>(1, static_cast<long int>(std::ceil(std::sqrt(static_cast<double>(n_lattice_sensors))))); 
+    const long int spacing = area / per_side + 1; 
+
+    std::vector<Sensor> sensors; 
+    auto write_sensor = [&](long int sx, long int sy, long int bx, long int by) {
+        os << "Sensor at x=" << sx << ", y=" << sy << ": closest beacon is at x=" << bx << ", y=" << by << '\n'; 
+        sensors.push_back(Sensor{sx, sy, std::abs(bx - sx) + std::abs(by - sy)}); 
+    }; 
+
+    for (size_t i = 0; i < n_lattice_sensors; ++i) {
+        long int sx, sy, distance; 
+        do {
+            auto cell = static_cast<long int>(i) % (per_side * per_side); 
+            sx = (cell % per_side) * spacing + spacing / 2 + uniform(rng, -spacing / 4, spacing / 4); 
+            sy = (cell / per_side) * spacing + spacing / 2 + uniform(rng, -spacing / 4, spacing / 4); 
+            distance = std::abs(sx - hole_x) + std::abs(sy - hole_y); 
+        } while (distance < 2); 
+        auto radius = std::min(2 * spacing, distance - 1); 
+        auto dx = uniform(rng, -radius, radius); 
+        auto dy = (chance(rng, 0.5) ? 1 : -1) * (radius - std::abs(dx)); 
+        write_sensor(sx, sy, sx + dx, sy + dy); 
+    }
+
+    // The frame: a sensor at distance (k, k) of the distress beacon with its beacon on one of the neighbours has a 
+    // range of 2k - 1, i.e. its edge runs along the diagonal next to the distress beacon. With k > area, each one 
+    // covers the half of the area on its side of that diagonal 
+    const long int k = area + 1; 
+    write_sensor(hole_x - k, hole_y - k, hole_x - 1, hole_y); 
+    write_sensor(hole_x + k, hole_y + k, hole_x + 1, hole_y); 
+    write_sensor(hole_x - k, hole_y + k, hole_x, hole_y + 1); 
+    write_sensor(hole_x + k, hole_y - k, hole_x, hole_y - 1); 
+
+    check_day15(sensors, area, hole_x, hole_y); 
+}
+
+// Day 16: connected network of valves (at most 26^2), at most 15 of which have a non-zero flow rate 
+void generate_day16(std::ostream& os, size_t n_valves, std::mt19937_64& rng) {
+    n_valves = std::min<size_t>(std::max<size_t>(n_valves, 2), 26 * 26); 
+    std::vector<std::string> names; 
+    for (size_t i = 0; i < 26 * 26; ++i) names.push_back(name_from_index(i, 2, UPPERCASE)); 
+    shuffle(names, rng); 
+    names.resize(n_valves); 
+    if (std::find(names.begin(), names.end(), "AA") == names.end()) names[0] = "AA"; 
+    std::swap(*std::find(names.begin(), names.end(), "AA"), names[0]); 
+
+    std::vector<std::vector<size_t>> tunnels(n_valves); 
+    auto connect = [&](size_t a, size_t b) {
+        if (a == b || std::find(tunnels[a].begin(), tunnels[a].end(), b) != tunnels[a].end()) return; 
+        tunnels[a].push_back(b); 
+        tunnels[b].push_back(a); 
+    }; 
+    for (size_t i = 1; i < n_valves; ++i) connect(i, uniform(rng, 0, i - 1)); 
+    for (size_t i = 0; i < n_valves / 2; ++i) connect(uniform(rng, 0, n_valves - 1), uniform(rng, 0, n_valves - 1)); 
+
+    std::vector<unsigned int> flow_rates(n_valves, 0); 
+    for (size_t i = 0; i < std::min<size_t>(15, n_valves / 4 + 1) && n_valves > 1; ++i) flow_rates[uniform(rng, 1, n_valves - 1)] = uniform(rng, 3, 25); 
+
+    std::vector<size_t> order(n_valves); 
+    for (size_t i = 0; i < n_valves; ++i) order[i] = i; 
+    shuffle(order, rng); 
+    for (auto v: order) {
+        bool is_single = tunnels[v].size() == 1; 
+        os << "Valve " << names[v] << " has flow rate=" << flow_rates[v] << (is_single ? "; tunnel leads to valve " : "; tunnels lead to valves "); 
+        for (size_t i = 0; i < tunnels[v].size(); ++i) os << (i > 0 ? ", " : "") << names[tunnels[v][i]]; 
+        os << '\n'; 
+    }
+}
+
+// Day 17: jet pattern 
+void generate_day17(std::ostream& os, size_t n_jets, std::mt19937_64& rng) {
+    for (size_t i = 0; i < n_jets; ++i) os << (chance(rng, 0.5) ? '<' : '>'); 
+    os << '\n'; 
+}
+
+// Day 18: distinct cubes filling about a third of a cubic box 
+void generate_day18(std::ostream& os, size_t n_cubes, std::mt19937_64& rng) {
+    auto side = std::max<long int>(3, static_cast<long int>(std::cbrt(n_cubes * 3.0)) + 1); 
+    n_cubes = std::min<size_t>(n_cubes, side * side * side); 
+    std::unordered_set<long int> cubes; 
+    while (cubes.size() < n_cubes) {
+        long int x = uniform(rng, 0, side - 1), y = uniform(rng, 0, side - 1), z = uniform(rng, 0, side - 1); 
+        if (cubes.insert((x * side + y) * side + z).second) os << x << ',' << y << ',' << z << '\n'; 
+    }
+}
+
+// Day 19: blueprints with robot costs in the same ranges as the puzzle input 
+void generate_day19(std::ostream& os, size_t n_blueprints, std::mt19937_64& rng) {
+    for (size_t i = 1; i <= n_blueprints; ++i) {
+        os << "Blueprint " << i << ": Each ore robot costs " << uniform(rng, 2, 4) << " ore. Each clay robot costs "
+           << uniform(rng, 2, 4) << " ore. Each obsidian robot costs " << uniform(rng, 2, 4) << " ore and "
+           << uniform(rng, 5, 20) << " clay. Each geode robot costs " << uniform(rng, 2, 4) << " ore and "
+           << uniform(rng, 7, 20) << " obsidian.\n"; 
+    }
+}
+
+// Day 20: list of numbers containing exactly one 0 
+void generate_day20(std::ostream& os, size_t n_numbers, std::mt19937_64& rng) {
+    n_numbers = std::max<size_t>(n_numbers, 2); 
+    auto zero_index = static_cast<size_t>(uniform(rng, 0, n_numbers - 1)); 
+    for (size_t i = 0; i < n_numbers; ++i) {
+        long int n = 0; 
+        while (i != zero_index && n == 0) n = uniform(rng, -10000, 10000); 
+        os << n << '\n'; 
+    }
+}
+
+// Day 21: random expression tree of monkeys yelling positive numbers only (every division is exact), with 
+// root at the top and humn as one of the leaves 
+struct MonkeyTree {
+    std::mt19937_64& rng; 
+    std::vector<std::string> lines; 
+    size_t next_name = 0; 
+    size_t humn_leaf; 
+    size_t n_leaves = 0; 
+
+    std::string new_name() {
+        std::string name; 
+        do { name = name_from_index(next_name++, 4); } while (name == "root" || name == "humn"); 
+        return name; 
+    }
+
+    // Generates a subtree with the given number of leaves, returns its name and value 
+    std::pair<std::string, long int> generate(size_t leaves, const std::string& name) {
+        if (leaves == 1) {
+            long int value = uniform(rng, 1, 20); 
+            auto leaf_name = n_leaves++ == humn_leaf ? std::string("humn") : name; 
+            lines.push_back(leaf_name + ": " + std::to_string(value)); 
+            return {leaf_name, value}; 
+        }
+        auto left_leaves = static_cast<size_t>(uniform(rng, 1, leaves - 1)); 
+        auto left = generate(left_leaves, new_name()); 
+        auto right = generate(leaves - left_leaves, new_name()); 
+
+        const long int max_value = 1000000000000L; 
+        auto valid_ops = [&]() {
+            std::string ops; 
+            if (left.second + right.second <= max_value) ops += '+'; 
+            if (left.second > right.second) ops += '-'; 
+            if (left.second <= max_value / right.second) ops += '*'; 
+            if (left.second % right.second == 0) ops += '/'; 
+            return ops; 
+        }; 
+        // With the larger operand on the left, at least one of '-' and '/' is always valid 
+        if (valid_ops().empty() || chance(rng, 0.5)) std::swap(left, right); 
+        if (valid_ops().empty()) std::swap(left, right); 
+        auto ops = valid_ops(); 
+        char op = ops[uniform(rng, 0, ops.size() - 1)]; 
+        long int value = op == '+' ? left.second + right.second : op == '-' ? left.second - right.second :
+                         op == '*' ? left.second * right.second : left.second / right.second; 
+        lines.push_back(name + ": " + left.first + ' ' + op + ' ' + right.first); 
+        return {name, value}; 
+    }
+}; 
+
+void generate_day21(std::ostream& os, size_t n_monkeys, std::mt19937_64& rng) {
+    // A tree with n leaves has 2n - 1 monkeys; names have four letters 
+    auto n_leaves = std::min<size_t>(std::max<size_t>((n_monkeys + 1) / 2, 2), 200000); 
+    MonkeyTree tree{rng, {}, 0, static_cast<size_t>(uniform(rng, 0, n_leaves - 1))}; 
+    tree.generate(n_leaves, "root"); 
+    shuffle(tree.lines, rng); 
+    for (const auto& line: tree.lines) os << line << '\n'; 
+}
+
+// Day 22: the cube net of the puzzle input (faces of 50x50, which the solution of part two relies on) 
+// with random walls, followed by the given number of moves 
+void generate_day22(std::ostream& os, size_t n_moves, std::mt19937_64& rng) {
+    const size_t face = 50; 
+    // Face columns of every row of faces: the same layout as the puzzle input 
+    const std::vector<std::pair<size_t, size_t>> face_columns{{1, 3}, {1, 2}, {0, 2}, {0, 1}}; 
+    for (size_t face_row = 0; face_row < face_columns.size(); ++face_row) {
+        for (size_t row = 0; row < face; ++row) {
+            std::string line(face_columns[face_row].first * face, ' '); 
+            for (size_t col = face_columns[face_row].first * face; col < face_columns[face_row].second * face; ++col) {
+                // The starting position (leftmost open tile of the top row) must be open 
+                line += (face_row == 0 && row == 0 && col == face) || !chance(rng, 0.08) ? '.' : '#'; 
+            }
+            os << line << '\n'; 
+        }
+    }
+    os << '\n'; 
+    for (size_t i = 0; i < n_moves; ++i) {
+        if (i > 0) os << (chance(rng, 0.5) ? 'R' : 'L'); 
+        os << uniform(rng, 1, 50); 
+    }
+    os << '\n'; 
+}
+
+// Day 23: square grove about half full of elves 
+void generate_day23(std::ostream& os, size_t side, std::mt19937_64& rng) {
+    for (size_t row = 0; row < side; ++row) {
+        for (size_t col = 0; col < side; ++col) os << (chance(rng, 0.5) ? '#' : '.'); 
+        os << '\n'; 
+    }
+}
+
+// Day 24: valley four times as wide as high, with no vertical blizzards in the columns of the entrance 
+// and of the exit (they would leave the valley) 
+void generate_day24(std::ostream& os, size_t height, std::mt19937_64& rng) {
+    height = std::max<size_t>(height, 2); 
+    const size_t width = 4 * height; 
+    const std::string blizzards = "<>^v"; 
+    os << "#." << std::string(width, '#') << '\n'; 
+    for (size_t row = 0; row < height; ++row) {
+        os << '#'; 
+        for (size_t col = 0; col < width; ++col) {
+            bool is_vertical_free = col == 0 || col == width - 1; 
+            os << (chance(rng, 0.5) ? '.' : blizzards[uniform(rng, 0, is_vertical_free ? 1 : 3)]); 
+        }
+        os << "#\n"; 
+    }
+    os << std::string(width, '#') << ".#\n"; 
+}
+
+// Day 25: SNAFU numbers of up to 16 digits (so that their sum fits in 64 bits for millions of numbers) 
+void generate_day25(std::ostream& os, size_t n_numbers, std::mt19937_64& rng) {
+    const std::string digits = "=-012"; 
+    for (size_t i = 0; i < n_numbers; ++i) {
+        os << digits[uniform(rng, 3, 4)]; 
+        for (auto n = uniform(rng, 0, 15); n > 0; --n) os << digits[uniform(rng, 0, 4)]; 
+        os << '\n'; 
+    }
+}
+
+const InputGenerator GENERATORS[] = {
+    {1, "elves", generate_day01},
+    {2, "rounds", generate_day02},
+    {3, "rucksacks", generate_day03},
+    {4, "pairs", generate_day04},
+    {5, "moves", generate_day05},
+    {6, "characters", generate_day06},
+    {7, "directories", generate_day07},
+    {8, "rows and columns", generate_day08},
+    {9, "motions", generate_day09},
+    {10, "instructions", generate_day10},
+    {11, "items", generate_day11},
+    {12, "rows and columns", generate_day12},
+    {13, "pairs", generate_day13},
+    {14, "rock paths", generate_day14},
+    {15, "sensors", generate_day15},
+    {16, "valves", generate_day16},
+    {17, "jets", generate_day17},
+    {18, "cubes", generate_day18},
+    {19, "blueprints", generate_day19},
+    {20, "numbers", generate_day20},
+    {21, "monkeys", generate_day21},
+    {22, "moves", generate_day22},
+    {23, "rows and columns", generate_day23},
+    {24, "rows", generate_day24},
+    {25, "numbers", generate_day25},
+}; 
+
+} // namespace
+
+const InputGenerator* find_generator(int day) {
+    for (const auto& g: GENERATORS) {
+        if (g.day == day) return &g; 
+    }
+    return nullptr; 
+}
+
+void generate_input(const InputGenerator& generator, size_t size, std::uint64_t seed, std::ostream& os) {
+    // Mixing in the day number gives every day its own sequence for the same seed 
+    std::mt19937_64 rng(seed * 31 + generator.day); 
+    generator.generate(os, size, rng); 
+}
+
+} // namespace bench
+} // namespace aoc
@@ -0,0 +1,33 @@
+#ifndef AOC2022_BENCH_GENERATORS_H
+#define AOC2022_BENCH_GENERATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+
+// Generators of synthetic puzzle inputs of any size, used to find out how the solutions scale far beyond the 
+// size of the puzzle inputs. Every generator writes an input which is valid for its day (i.e. it respects the 
+// invariants the solutions rely on), and the same (day, size, seed) always gives the same input. 
+
+namespace aoc {
+namespace bench {
+
+using Generator = void (*)(std::ostream& os, size_t size, std::mt19937_64& rng); 
+
+struct InputGenerator {
+    int day; 
+    const char* size_unit;  // what the size of the generated input counts, e.g. "elves"
+    Generator generate; 
+}; 
+
+// The generator of a day, or nullptr if the day number is unknown 
+const InputGenerator* find_generator(int day); 
+
+// Writes the input of the given day and size, generated from the given seed 
+void generate_input(const InputGenerator& generator, size_t size, std::uint64_t seed, std::ostream& os); 
+
+} // namespace bench
+} // namespace aoc
+
+#endif
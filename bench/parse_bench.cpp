@@ -0,0 +1,192 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <regex>
+#include <cstdint>
+#include <iomanip>
+
+#include "benchmark.h"
+#include "generators.h"
+#include "input.h"
+
+// Micro-benchmark of the parsing of the inputs with a fixed format (days 15, 16 and 19): the regular expressions 
+// the days used to parse their lines with, against the shared line scanner (aoc::scan_line). Both parsers extract 
+// the same numbers and identifiers from a generated input held in memory, and the throughput is reported in MB/s. 
+
+struct Options {
+    size_t repetitions = 5; 
+    size_t size = 0;            // 0: the default size of each day 
+    std::uint64_t seed = 0; 
+}; 
+
+void print_usage() {
+    std::cerr << "Usage: aoc2022_parse_bench [--size N] [--repetitions N] [--seed S]\n"
+                 "  --size N         size of the generated inputs, in the unit of each day (default: about 5 MB, \n"
+                 "                   except for day 16 whose inputs cannot be larger than 676 valves)\n"
+                 "  --repetitions N  timed runs of each parser (default: 5)\n"
+                 "  --seed S         seed of the generated inputs (default: 0)" << std::endl; 
+}
+
+bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]); 
+        if (arg == "--size" && i + 1 < argc) {
+            options.size = aoc::to_int<size_t>(argv[++i]); 
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max<size_t>(aoc::to_int<size_t>(argv[++i]), 1); 
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = aoc::to_int<std::uint64_t>(argv[++i]); 
+        } else {
+            return false; 
+        }
+    }
+    return true; 
+}
+
+// The parsers return a checksum of what they extracted (the sum of the numbers, plus the letters of the 
+// identifiers), so that the two of them can be checked against each other 
+using Parser = std::uint64_t (*)(std::string_view text); 
+
+std::uint64_t add_identifier(std::uint64_t checksum, std::string_view name) {
+    return checksum + static_cast<unsigned char>(name[0]) * 26 + static_cast<unsigned char>(name[1]); 
+}
+
+std::uint64_t parse_day15_regex(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    std::regex pattern("Sensor at x=(-?\\d+), y=(-?\\d+): closest beacon is at x=(-?\\d+), y=(-?\\d+)"); 
+    std::cmatch match; 
+    for (auto line: aoc::lines(text)) {
+        if (std::regex_search(line.data(), line.data() + line.size(), match, pattern) && match.size() == 5) {
+            for (size_t i = 1; i <= 4; ++i) checksum += static_cast<std::uint64_t>(std::stol(match[i].str())); 
+        }
+    }
+    return checksum; 
+}
+
+std::uint64_t parse_day15_scanner(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    std::array<long int, 4> numbers; 
+    for (auto line: aoc::lines(text)) {
+        if (aoc::scan_ints<long int>(line, numbers) == 4) {
+            for (auto n: numbers) checksum += static_cast<std::uint64_t>(n); 
+        }
+    }
+    return checksum; 
+}
+
+std::uint64_t parse_day16_regex(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    std::regex pattern(R"(Valve ([A-Z]{2}) has flow rate=(\d+); \btunnels?\b \bleads?\b to \bvalves? (([A-Z]+, ?)*[A-Z]+))"); 
+    std::cmatch match; 
+    for (auto line: aoc::lines(text)) {
+        if (std::regex_search(line.data(), line.data() + line.size(), match, pattern) && match.size() >= 4) {
+            checksum = add_identifier(checksum, match[1].str()); 
+            checksum += static_cast<std::uint64_t>(std::stoi(match[2].str())); 
+            auto neighbors = match[3].str(); 
+            size_t start = 0; 
+            while (true) {
+                auto found_comma = neighbors.find(',', start); 
+                checksum = add_identifier(checksum, neighbors.substr(start, found_comma - start)); 
+                if (found_comma == std::string::npos) break; 
+                start = found_comma + 2; 
+            }
+        }
+    }
+    return checksum; 
+}
+
+std::uint64_t parse_day16_scanner(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    for (auto line: aoc::lines(text)) {
+        aoc::scan_line<unsigned int>(line, [&](unsigned int n) { checksum += n; }, 
+                                     [&](std::string_view name) { checksum = add_identifier(checksum, name); }); 
+    }
+    return checksum; 
+}
+
+// As day 19 did, the regular expression is built again for every line 
+std::uint64_t parse_day19_regex(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    for (auto line: aoc::lines(text)) {
+        std::regex pattern("\\b(\\d+)\\b"); 
+        auto begin = std::cregex_iterator(line.data(), line.data() + line.size(), pattern); 
+        auto end = std::cregex_iterator(); 
+        for (auto it = begin; it != end; ++it) checksum += static_cast<std::uint64_t>(std::stol((*it)[1].str())); 
+    }
+    return checksum; 
+}
+
+std::uint64_t parse_day19_scanner(std::string_view text) {
+    std::uint64_t checksum = 0; 
+    std::array<long int, 7> numbers; 
+    for (auto line: aoc::lines(text)) {
+        if (aoc::scan_ints<long int>(line, numbers) >= numbers.size()) {
+            for (auto n: numbers) checksum += static_cast<std::uint64_t>(n); 
+        }
+    }
+    return checksum; 
+}
+
+struct ParseBenchmark {
+    int day; 
+    size_t default_size; 
+    Parser regex_parser; 
+    Parser scanner_parser; 
+}; 
+
+const std::vector<ParseBenchmark> BENCHMARKS{
+    {15, 60000, parse_day15_regex, parse_day15_scanner}, 
+    {16, 676, parse_day16_regex, parse_day16_scanner}, 
+    {19, 30000, parse_day19_regex, parse_day19_scanner}, 
+}; 
+
+// Throughput (MB/s) of the median run of a parser 
+double measure_throughput(Parser parser, std::string_view text, size_t repetitions, std::uint64_t& checksum) {
+    checksum = parser(text);  // warmup 
+    std::vector<double> samples; 
+    for (size_t r = 0; r < repetitions; ++r) {
+        samples.push_back(aoc::bench::time_ns([&]() { checksum = parser(text); })); 
+    }
+    auto median_ns = aoc::bench::summarize(samples).median; 
+    return median_ns > 0 ? text.size() / median_ns * 1e3 : 0; 
+}
+
+int main(int argc, char* argv[]) {
+
+    Options options; 
+    if (!parse_options(argc, argv, options)) {
+        print_usage(); 
+        return 1; 
+    }
+
+    if (!aoc::bench::is_optimized_build()) {
+        std::cerr << "Warning: the benchmarks were built without optimizations "
+                     "(configure with -DCMAKE_BUILD_TYPE=Release)" << std::endl; 
+    }
+
+    std::cout << std::fixed << std::setprecision(1); 
+    std::cout << "  day        size      bytes  regex (MB/s)  scanner (MB/s)  speedup" << std::endl; 
+    int result = 0; 
+    for (const auto& b: BENCHMARKS) {
+        auto size = options.size > 0 ? options.size : b.default_size; 
+        std::ostringstream input; 
+        aoc::bench::generate_input(*aoc::bench::find_generator(b.day), size, options.seed, input); 
+        auto text = input.str(); 
+
+        std::uint64_t regex_checksum = 0, scanner_checksum = 0; 
+        auto regex_throughput = measure_throughput(b.regex_parser, text, options.repetitions, regex_checksum); 
+        auto scanner_throughput = measure_throughput(b.scanner_parser, text, options.repetitions, scanner_checksum); 
+
+        std::cout << std::setw(5) << b.day << std::setw(12) << size << std::setw(11) << text.size() 
+                  << std::setw(14) << regex_throughput << std::setw(16) << scanner_throughput 
+                  << std::setw(8) << (regex_throughput > 0 ? scanner_throughput / regex_throughput : 0) << "x" << std::endl; 
+        if (regex_checksum != scanner_checksum) {
+            std::cerr << "Day " << b.day << ": the parsers disagree (" << regex_checksum << " vs " << scanner_checksum << ")" << std::endl; 
+            result = 1; 
+        }
+    }
+    return result; 
+}
@@ -2,7 +2,7 @@
 
 day="day$1"
 cd "./$day"
-g++ "$day.cpp" -o "$day" 
+g++ -std=c++17 -pthread -I../common "$day.cpp" ../common/*.cpp -o "$day" 
 if [ "$2" == "test" ]; then
     "./$day" "test" 
 else 
@@ -0,0 +1,79 @@
+#include "day.h"
+
+#include <algorithm>
+#include <iostream>
+#include <exception>
+
+namespace aoc {
+
+namespace {
+thread_local std::ostream* output = &std::cout; 
+}
+
+std::ostream& out() {
+    return *output; 
+}
+
+void redirect_output(std::ostream& stream) {
+    output = &stream; 
+}
+
+void print_header(const Day& day) {
+    out() << ">>> Advent Of Code 2022 - Day " << day.number << " <<<" << std::endl; 
+}
+
+bool take_flag(int& argc, char* argv[], std::string_view name) {
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] != name) continue; 
+        std::copy(argv + i + 1, argv + argc, argv + i); 
+        --argc; 
+        return true; 
+    }
+    return false; 
+}
+
+bool take_option(int& argc, char* argv[], std::string_view name, std::string_view& value) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (argv[i] != name) continue; 
+        value = argv[i + 1]; 
+        std::copy(argv + i + 2, argv + argc, argv + i); 
+        argc -= 2; 
+        return true; 
+    }
+    return false; 
+}
+
+void take_day_options(const Day& day, int& argc, char* argv[]) {
+    for (const auto& option: day.options) {
+        std::string_view value; 
+        while (option.has_value ? take_option(argc, argv, option.name, value) : take_flag(argc, argv, option.name)) {
+            option.apply(value); 
+        }
+    }
+}
+
+int run_day(const Day& day, int argc, char* argv[]) {
+
+    take_day_options(day, argc, argv); 
+    print_header(day); 
+
+    bool is_test = argc > 1 && std::string(argv[1]) == "test"; 
+    std::string file_name = is_test ? "./test.txt" : "./input.txt"; 
+
+    // As in the runner, a day which fails (e.g. on a malformed input) reports it rather than aborting 
+    try {
+        day.load(file_name, is_test); 
+
+        if (is_test) day.print(); 
+
+        day.part_one(); 
+        day.part_two(); 
+    } catch (const std::exception& e) {
+        std::cerr << "Day " << day.number << " failed: " << e.what() << std::endl; 
+        return 1; 
+    }
+
+    return 0; 
+}
+
+} // namespace aoc
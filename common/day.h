@@ -0,0 +1,58 @@
+#ifndef AOC2022_COMMON_DAY_H
+#define AOC2022_COMMON_DAY_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Every day exposes its solution through an aoc::Day object, which splits the old main() into its phases: 
+// importing the data, printing it (test mode only), and solving the two parts. The phases operate on the 
+// day's own data (kept in the day's namespace), so that a standalone dayNN executable and the aoc2022 
+// runner (which links all the days together) drive exactly the same code. 
+
+namespace aoc {
+
+// An extra command-line option of a day, either a flag ("--sort") or an option with a value ("--top K"). The 
+// options set the day's own settings, so they work the same in the dayNN executables, aoc2022 and aoc2022_bench 
+struct DayOption {
+    const char* name; 
+    bool has_value; 
+    void (*apply)(std::string_view value);  // the value is empty for a flag 
+}; 
+
+struct Day {
+    int number; 
+    void (*load)(const std::string& file_name, bool is_test);  // (re-)imports the input data 
+    void (*print)();            // prints the imported data (used for test cases)
+    void (*part_one)(); 
+    void (*part_two)(); 
+    std::vector<DayOption> options{}; 
+}; 
+
+// Output stream of the solvers. It defaults to std::cout, but it can be redirected for the calling 
+// thread only, which lets the runner execute several days concurrently without mixing their output. 
+std::ostream& out(); 
+void redirect_output(std::ostream& stream); 
+
+// Prints the day's header line 
+void print_header(const Day& day); 
+
+// Removes the flag "name" from the command line (anywhere in argv[1..argc)), updating argc. Returns true if 
+// the flag was there 
+bool take_flag(int& argc, char* argv[], std::string_view name); 
+
+// Removes the option "name VALUE" from the command line, updating argc, and stores its value. Returns true 
+// if the option was there (with a value) 
+bool take_option(int& argc, char* argv[], std::string_view name, std::string_view& value); 
+
+// Removes the options of the day from the command line, applying each one that is found 
+void take_day_options(const Day& day, int& argc, char* argv[]); 
+
+// Body of the main() of the standalone dayNN executables: applies the day's options, then reads ./input.txt 
+// (or ./test.txt if the first remaining argument is "test") and solves both parts. 
+int run_day(const Day& day, int argc, char* argv[]); 
+
+} // namespace aoc
+
+#endif
@@ -0,0 +1,40 @@
+#include "input.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aoc {
+
+InputFile::InputFile(const std::string& file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY); 
+    if (fd < 0) return; 
+
+    struct stat file_stat; 
+    if (::fstat(fd, &file_stat) == 0) {
+        size_ = static_cast<size_t>(file_stat.st_size); 
+        // An empty file cannot be mapped, but it is still a valid (empty) input 
+        if (size_ == 0) {
+            is_open_ = true; 
+        } else {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0); 
+            if (mapping != MAP_FAILED) {
+                // The input is always scanned front to back 
+                ::madvise(mapping, size_, MADV_SEQUENTIAL); 
+                data_ = static_cast<const char*>(mapping); 
+                is_open_ = true; 
+            } else {
+                size_ = 0; 
+            }
+        }
+    }
+    // The mapping stays valid after the descriptor is closed 
+    ::close(fd); 
+}
+
+InputFile::~InputFile() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_); 
+}
+
+} // namespace aoc
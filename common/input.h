@@ -0,0 +1,184 @@
+#ifndef AOC2022_COMMON_INPUT_H
+#define AOC2022_COMMON_INPUT_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Shared input layer for all days. The input file is memory-mapped once, and every line or 
+// field handed out by the helpers below is a std::string_view pointing straight into the mapping: 
+// no line is ever copied into a std::string and no stream is constructed while parsing. 
+// Integers are parsed by hand from the views (see to_int and next_int). 
+
+namespace aoc {
+
+// Iterates over the lines of a text, with the same semantics as std::getline: 
+// the '\n' separators are dropped and a trailing newline does not produce an extra empty line. 
+class LineIterator {
+    const char* pos_ = nullptr; 
+    const char* end_ = nullptr; 
+    std::string_view line_; 
+
+    void read_line() noexcept {
+        if (pos_ == end_) return; 
+        auto newline = static_cast<const char*>(std::memchr(pos_, '\n', static_cast<size_t>(end_ - pos_))); 
+        line_ = std::string_view(pos_, static_cast<size_t>((newline ? newline : end_) - pos_)); 
+    }
+
+    public: 
+    LineIterator() = default; 
+    LineIterator(const char* begin, const char* end) noexcept: pos_(begin), end_(end) { read_line(); }
+
+    std::string_view operator*() const noexcept { return line_; }
+
+    LineIterator& operator++() noexcept {
+        pos_ = line_.data() + line_.size(); 
+        if (pos_ != end_) ++pos_;   // skip the '\n' 
+        read_line(); 
+        return *this; 
+    }
+
+    bool operator==(const LineIterator& other) const noexcept { return pos_ == other.pos_; }
+    bool operator!=(const LineIterator& other) const noexcept { return pos_ != other.pos_; }
+}; 
+
+struct Lines {
+    std::string_view text; 
+
+    LineIterator begin() const noexcept { return {text.data(), text.data() + text.size()}; }
+    LineIterator end() const noexcept { 
+        auto end = text.data() + text.size(); 
+        return {end, end}; 
+    }
+}; 
+
+inline Lines lines(std::string_view text) noexcept {
+    return Lines{text}; 
+}
+
+// Read-only, memory-mapped input file. The mapping lives as long as the object, so the 
+// views returned by text() and lines() must not outlive it. 
+class InputFile {
+    const char* data_ = nullptr; 
+    size_t size_ = 0; 
+    bool is_open_ = false; 
+
+    public: 
+    explicit InputFile(const std::string& file_name); 
+    ~InputFile(); 
+
+    InputFile(const InputFile&) = delete; 
+    InputFile& operator=(const InputFile&) = delete; 
+
+    bool is_open() const noexcept { return is_open_; }
+    std::string_view text() const noexcept { return {data_, size_}; }
+    Lines lines() const noexcept { return Lines{text()}; }
+}; 
+
+// Splits off the text before the next delimiter and returns it; the text (and the delimiter) 
+// are consumed from the input view. If there is no delimiter, the whole remaining text is returned. 
+inline std::string_view next_field(std::string_view& text, char delimiter = ' ') noexcept {
+    auto found = text.find(delimiter); 
+    auto field = text.substr(0, found); 
+    text.remove_prefix(found == std::string_view::npos ? text.size() : found + 1); 
+    return field; 
+}
+
+// Removes the given prefix from the text if present. Returns true if it was found. 
+inline bool skip_prefix(std::string_view& text, std::string_view prefix) noexcept {
+    if (text.substr(0, prefix.size()) != prefix) return false; 
+    text.remove_prefix(prefix.size()); 
+    return true; 
+}
+
+// Parses the (optionally signed) integer at the beginning of the text, consuming its characters. 
+// Parsing stops at the first non-digit character; if there are no digits, 0 is returned. 
+template <typename T> 
+T parse_int(std::string_view& text) noexcept {
+    static_assert(std::is_integral<T>::value, "parse_int requires an integral type"); 
+    bool negative = false; 
+    size_t i = 0; 
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-'; 
+        ++i; 
+    }
+    T value = 0; 
+    while (i < text.size() && static_cast<unsigned char>(text[i] - '0') < 10) {
+        value = static_cast<T>(value * 10 + (text[i] - '0')); 
+        ++i; 
+    }
+    text.remove_prefix(i); 
+    return negative ? static_cast<T>(-value) : value; 
+}
+
+// Same as parse_int, without consuming the input (e.g. for lines holding a single number) 
+template <typename T> 
+T to_int(std::string_view text) noexcept {
+    return parse_int<T>(text); 
+}
+
+// Skips ahead to the next integer of the text (a '-' is taken as a sign only if it is directly 
+// followed by a digit) and parses it. Returns false if the text contains no more integers. 
+template <typename T> 
+bool next_int(std::string_view& text, T& value) noexcept {
+    size_t i = 0; 
+    while (i < text.size()) {
+        auto digit = static_cast<unsigned char>(text[i] - '0') < 10; 
+        auto sign = text[i] == '-' && i + 1 < text.size() && static_cast<unsigned char>(text[i + 1] - '0') < 10; 
+        if (digit || sign) break; 
+        ++i; 
+    }
+    if (i == text.size()) {
+        text = std::string_view{}; 
+        return false; 
+    }
+    text.remove_prefix(i); 
+    value = parse_int<T>(text); 
+    return true; 
+}
+
+// Scans a line in a single pass for its integers (optionally signed, as in next_int) and its identifiers (words of 
+// exactly two uppercase letters, e.g. the valve names of day 16), calling on_int(value) and on_identifier(view) in 
+// the order in which they appear. Everything else (words, punctuation) is skipped. Used instead of regular 
+// expressions for the inputs with a fixed format. 
+template <typename T, typename OnInt, typename OnIdentifier> 
+void scan_line(std::string_view line, OnInt&& on_int, OnIdentifier&& on_identifier) {
+    static_assert(std::is_integral<T>::value, "scan_line requires an integral type"); 
+    auto is_digit = [](char c) { return static_cast<unsigned char>(c - '0') < 10; }; 
+    auto is_upper = [](char c) { return static_cast<unsigned char>(c - 'A') < 26; }; 
+    auto is_letter = [&](char c) { return is_upper(c) || static_cast<unsigned char>(c - 'a') < 26; }; 
+
+    size_t i = 0; 
+    while (i < line.size()) {
+        auto c = line[i]; 
+        if (is_digit(c) || (c == '-' && i + 1 < line.size() && is_digit(line[i + 1]))) {
+            auto rest = line.substr(i); 
+            on_int(parse_int<T>(rest)); 
+            i = line.size() - rest.size(); 
+        } else if (is_letter(c)) {
+            auto start = i; 
+            while (i < line.size() && is_letter(line[i])) ++i; 
+            if (i - start == 2 && is_upper(line[start]) && is_upper(line[start + 1])) on_identifier(line.substr(start, 2)); 
+        } else {
+            ++i; 
+        }
+    }
+}
+
+// Collects the integers of a line into values (at most values.size() of them), in a single pass. Returns the number 
+// of integers found, which can be larger than values.size() 
+template <typename T, typename Array> 
+size_t scan_ints(std::string_view line, Array& values) {
+    size_t n_values = 0; 
+    scan_line<T>(line, [&](T value) {
+        if (n_values < values.size()) values[n_values] = value; 
+        ++n_values; 
+    }, [](std::string_view) {}); 
+    return n_values; 
+}
+
+} // namespace aoc
+
+#endif
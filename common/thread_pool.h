@@ -0,0 +1,39 @@
+#ifndef AOC2022_COMMON_THREAD_POOL_H
+#define AOC2022_COMMON_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+// Number of worker threads used when the caller does not ask for a specific amount 
+inline size_t default_concurrency() noexcept {
+    auto n = std::thread::hardware_concurrency(); 
+    return n > 0 ? n : 1; 
+}
+
+// Runs task(i) for every i in [0, n_tasks) on a pool of (at most) n_threads workers. The tasks are 
+// handed out one at a time from a shared counter, so that long and short tasks balance out across the 
+// workers. The calling thread takes part in the work, and the function returns when every task is done. 
+template <typename Task> 
+void parallel_for(size_t n_tasks, Task&& task, size_t n_threads = default_concurrency()) {
+    n_threads = std::max<size_t>(1, std::min(n_threads, n_tasks)); 
+    std::atomic<size_t> next_task{0}; 
+
+    auto worker = [&]() {
+        for (size_t i = next_task++; i < n_tasks; i = next_task++) task(i); 
+    }; 
+
+    std::vector<std::thread> workers; 
+    workers.reserve(n_threads - 1); 
+    for (size_t t = 1; t < n_threads; ++t) workers.emplace_back(worker); 
+    worker(); 
+    for (auto& w: workers) w.join(); 
+}
+
+} // namespace aoc
+
+#endif
@@ -1,111 +1,133 @@
 #include <vector> 
 #include <iostream> 
-#include <cstring> 
-#include <numeric>
-#include <sstream>
+#include <functional>
 #include <string> 
-#include <fstream> 
 #include <algorithm>
 
-std::vector<std::vector<int>> elf_calories; 
-bool is_test{false};  
+#include "day.h"
+#include "input.h"
 
-void get_data(const std::string&, std::vector<std::vector<int>>&); 
-void solve_part_one(const std::vector<std::vector<int>>&); 
-void solve_part_two(const std::vector<std::vector<int>>&); 
-auto find_largest_n(const std::vector<std::vector<int>>&, size_t ); 
+namespace day01 {
 
-int main(int argc, char* argv[]) {
+// Approach: the elves' totals are accumulated while the input is scanned, and only the largest K of them are 
+// kept, in a min-heap (the smallest of the kept totals is at the top, ready to be replaced by a larger one). 
+// This needs O(K) memory whatever the number of elves and items, and O(N log K) time. Both parts are answered 
+// from the same heap (K >= 3); a larger K can be requested from the command line with "--top K". 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 1 <<<" << std::endl; 
+std::vector<long int> largest_totals;  // min-heap of the largest elf totals 
+size_t top_k{3}; 
+bool print_top_k{false}; 
+std::string input_file_name; 
+bool is_test{false};  
 
-    std::string file_name{}; 
+void get_data(const std::string&, std::vector<long int>&, size_t); 
+void solve_part_one(const std::vector<long int>&); 
+void solve_part_two(const std::vector<long int>&); 
+long int sum_largest_n(const std::vector<long int>&, size_t); 
+
+void load(const std::string& file_name, bool test) {
+    is_test = test; 
+    input_file_name = file_name; 
+    largest_totals.clear(); 
+    get_data(file_name, largest_totals, std::max<size_t>(top_k, 3)); 
+}
 
-    if (argc > 1 && std::strcmp(argv[1], "test") == 0) {
-        is_test = true; 
+// The items are not kept in memory, so they are read again from the input 
+void print() {
+    aoc::InputFile input_file(input_file_name); 
+    bool is_new_elf = true; 
+    for (auto line: input_file.lines()) {
+        if (line.empty()) {
+            if (!is_new_elf) aoc::out() << "\n"; 
+            is_new_elf = true; 
+            continue; 
+        }
+        aoc::out() << line << " "; 
+        is_new_elf = false; 
     }
+    aoc::out() << "\n"; 
+}
 
-    if (is_test) {
-        file_name = "./test.txt"; 
-        // std::cout << input_string << std::endl; 
-    } else {
-        file_name = "./input.txt"; 
+void part_one() { solve_part_one(largest_totals); }
+void part_two() { 
+    solve_part_two(largest_totals); 
+    if (print_top_k) {
+        aoc::out() << "The total of the top " << top_k << " elves is: " << sum_largest_n(largest_totals, top_k) << std::endl; 
     }
+}
 
-    get_data(file_name, elf_calories); 
+// "--top K" also prints the total of the K elves carrying the most calories 
+void set_top_k(std::string_view k) {
+    top_k = std::max<size_t>(aoc::to_int<size_t>(k), 1); 
+    print_top_k = true; 
+}
 
-    if (is_test) {
-        for (auto e: elf_calories) {
-            for (auto c: e) {
-                std::cout << c  << " " ;
-            }
-            std::cout << "\n"; 
-        }
+extern const aoc::Day day{1, load, print, part_one, part_two, {
+    {"--top", true, set_top_k}
+}}; 
+
+// Adds an elf's total to the heap if it is among the largest k seen so far 
+void push_total(std::vector<long int>& heap, long int total, size_t k) {
+    if (heap.size() < k) {
+        heap.push_back(total); 
+        std::push_heap(heap.begin(), heap.end(), std::greater<long int>()); 
+    } else if (total > heap.front()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<long int>()); 
+        heap.back() = total; 
+        std::push_heap(heap.begin(), heap.end(), std::greater<long int>()); 
     }
+}
 
-    solve_part_one(elf_calories); 
-    solve_part_two(elf_calories); 
-    
-    return 0; 
+void get_data(const std::string& file_name, std::vector<long int>& largest_totals, size_t k) {
 
-}
+    aoc::InputFile input_file(file_name); 
+    long int elf_total = 0; 
+    bool has_items = false; 
 
-void get_data(const std::string& file_name, std::vector<std::vector<int>>& elf_data) {
-
-    std::ifstream input_file(file_name); 
-    // std::istringstream data_stream(data_string); 
-    std::string line; 
-    int calories; 
-    std::vector<int> elf;
-
-    while (std::getline(input_file, line)) {
-        // std::cout << line << std::endl; 
-        if (line == "\n" || line == "") {
-            if (elf.size() > 0) {
-                elf_data.push_back(elf); 
-                elf.clear(); 
-                // elf = std::vector<int>{}; 
+    for (auto line: input_file.lines()) {
+        if (line.empty()) {
+            if (has_items) {
+                push_total(largest_totals, elf_total, k); 
+                elf_total = 0; 
+                has_items = false; 
             }
             continue; 
         }
-        std::istringstream(line) >> calories; 
-        elf.push_back(calories); 
+        elf_total += aoc::to_int<long int>(line); 
+        has_items = true; 
     }
 
-    elf_data.push_back(elf); 
-
-    input_file.close(); 
+    if (has_items) push_total(largest_totals, elf_total, k); 
 
 }
 
-auto find_largest_n(const std::vector<std::vector<int>>& elf_calories, size_t n) {
-    std::vector<int> total_elf_calories; 
-    for (const auto& elf: elf_calories) {
-        total_elf_calories.push_back(std::accumulate(elf.begin(), elf.end(), 0)); 
-    }
-    std::sort(total_elf_calories.begin(), total_elf_calories.end(), [](int e1, int e2) {
-        return e1 > e2; 
-    }); 
+long int sum_largest_n(const std::vector<long int>& largest_totals, size_t n) {
+    // The heap holds at most K totals, so sorting a copy of it is cheap 
+    std::vector<long int> totals(largest_totals); 
+    std::sort(totals.begin(), totals.end(), std::greater<long int>()); 
 
-    int sum_first_n = 0; 
-    for (size_t i = 0; i < n; i++) {
-        sum_first_n += total_elf_calories.at(i); 
+    // With fewer than n elves, the missing ones carry nothing 
+    long int sum_first_n = 0; 
+    for (size_t i = 0; i < std::min(n, totals.size()); i++) {
+        sum_first_n += totals.at(i); 
     }
     return sum_first_n; 
 }
 
-void solve_part_one(const std::vector<std::vector<int>>& elf_calories) { 
-    // int max_calories = 0; 
-    // for (const auto& elf: elf_calories) {
-    //     auto current_calories = std::accumulate(elf.begin(), elf.end(), 0); 
-    //     if (current_calories > max_calories) max_calories = current_calories; 
-    // }
-    auto max_calories = find_largest_n(elf_calories, 1); 
-    std::cout << "The answer of part one is: " << max_calories << std::endl; 
+void solve_part_one(const std::vector<long int>& largest_totals) { 
+    auto max_calories = sum_largest_n(largest_totals, 1); 
+    aoc::out() << "The answer of part one is: " << max_calories << std::endl; 
 }
 
-void solve_part_two(const std::vector<std::vector<int>>& elf_calories) { 
-    auto max_calories = find_largest_n(elf_calories, 3); 
-    std::cout << "The answer of part two is: " << max_calories << std::endl; 
+void solve_part_two(const std::vector<long int>& largest_totals) { 
+    auto max_calories = sum_largest_n(largest_totals, 3); 
+    aoc::out() << "The answer of part two is: " << max_calories << std::endl; 
 }
 
+} // namespace day01
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day01::day, argc, argv); 
+}
+#endif
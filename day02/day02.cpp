@@ -1,149 +1,115 @@
 #include <iostream> 
 #include <string>
-#include <fstream>
-#include <sstream>
-#include <utility> 
-#include <vector> 
-#include <unordered_map> 
-
-using Move = std::pair<char, char>; // a rock-paper-scissor move for each pair of players 
-
-void get_data(const std::string&, std::vector<Move>&); 
-auto calculate_scores(const std::vector<Move>&); 
-auto convert_move(const std::vector<Move>&); 
-void solve_part_one(const std::vector<Move>&); 
-void solve_part_two(const std::vector<Move>&); 
+#include <array> 
+
+#include "day.h"
+#include "input.h"
+
+namespace day02 {
+
+// Approach: there are only 3x3 different rounds, so the score of each of them is precomputed (at compile time) 
+// in a lookup table for both interpretations of the second column. The input is scanned once, counting how many 
+// times each of the nine rounds occurs; the total score of either part is then the sum of the nine counts 
+// weighted by the corresponding table. 
+
+// Index of a round in the tables: 3 * (A, B, C -> 0, 1, 2) + (X, Y, Z -> 0, 1, 2) 
+using RoundCounts = std::array<long int, 9>; 
+using ScoreTable = std::array<int, 9>; 
+
+// First player: A = rock; B = paper; C = scissors; 
+// Part one: X = rock (1); Y = paper (2); Z = scissors (3); 
+// Part two: X = lose; Y = draw; Z = win; 
+// Loss = 0; Draw = 3; Win = 6; 
+constexpr ScoreTable make_score_table(bool is_part_two) {
+    ScoreTable table{}; 
+    for (int a = 0; a < 3; ++a) {
+        for (int x = 0; x < 3; ++x) {
+            // The second player's shape, and the outcome (0 = loss, 1 = draw, 2 = win) 
+            int shape = is_part_two ? (a + x + 2) % 3 : x; 
+            int outcome = (shape - a + 4) % 3; 
+            table[3 * a + x] = shape + 1 + 3 * outcome; 
+        }
+    }
+    return table; 
+}
 
-int main(int argc, char* argv[]) {
+constexpr ScoreTable PART_ONE_SCORES = make_score_table(false); 
+constexpr ScoreTable PART_TWO_SCORES = make_score_table(true); 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 2 <<<" << std::endl; 
+static_assert(PART_ONE_SCORES[0 * 3 + 1] == 8 && PART_ONE_SCORES[1 * 3 + 0] == 1 && PART_ONE_SCORES[2 * 3 + 2] == 6, 
+              "Part one: A Y = 8, B X = 1, C Z = 6"); 
+static_assert(PART_TWO_SCORES[0 * 3 + 1] == 4 && PART_TWO_SCORES[1 * 3 + 0] == 1 && PART_TWO_SCORES[2 * 3 + 2] == 7, 
+              "Part two: A Y = 4, B X = 1, C Z = 7"); 
 
-    std::vector<Move> strategies; 
-    std::string file_name{}; 
-    bool is_test{false};
-    if (argc > 1 && std::string{argv[1]} == "test") {
-        is_test = true; 
-    } 
+void get_data(const std::string&, RoundCounts&); 
+long int calculate_score(const RoundCounts&, const ScoreTable&); 
+void solve_part_one(const RoundCounts&); 
+void solve_part_two(const RoundCounts&); 
 
-    if (is_test) {
-        file_name = "./test.txt";
-    } else {
-        file_name = "./input.txt";
-    }
+RoundCounts round_counts; 
+std::string input_file_name; 
 
-    get_data(file_name, strategies); 
+void load(const std::string& file_name, bool) {
+    input_file_name = file_name; 
+    round_counts.fill(0); 
+    get_data(file_name, round_counts); 
+}
 
-    if (is_test) {
-        for (const auto& s: strategies) {
-            std::cout << "Move A: " << s.first << " ";
-            std::cout << "Move B: " << s.second << "\n"; 
-        }
+// Only the counts of the rounds are kept, so the moves are read again from the input 
+void print() {
+    aoc::InputFile input_file(input_file_name); 
+    for (auto line: input_file.lines()) {
+        if (line.size() < 3) continue; 
+        aoc::out() << "Move A: " << line[0] << " ";
+        aoc::out() << "Move B: " << line[2] << "\n"; 
     }
+}
 
-    solve_part_one(strategies); 
-    solve_part_two(strategies); 
+void part_one() { solve_part_one(round_counts); }
+void part_two() { solve_part_two(round_counts); }
 
-    return 0; 
-}
+extern const aoc::Day day{2, load, print, part_one, part_two}; 
 
-void get_data(const std::string& file_name, std::vector<Move>& strategies) {
+void get_data(const std::string& file_name, RoundCounts& round_counts) {
 
-    std::ifstream input_file(file_name); 
+    aoc::InputFile input_file(file_name); 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            char moveA, moveB; 
-            std::istringstream line_stream(line);
-            line_stream >> moveA >> moveB; 
-            // std::cout << "Move A: " << moveA << ", Move B: " << moveB << std::endl; 
-            Move newMove(moveA, moveB); 
-            strategies.push_back(newMove); 
+        for (auto line: input_file.lines()) {
+            if (line.size() < 3) continue; 
+            // Each line is "<move A> <move B>" 
+            unsigned int a = line[0] - 'A', x = line[2] - 'X'; 
+            if (a < 3 && x < 3) ++round_counts[3 * a + x]; 
         }
     } else {
         std::cerr << "File not found." << std::endl; 
         return; 
     }
-    input_file.close(); 
 }
 
-auto calculate_scores(const std::vector<Move>& strategies) {
-
-    // First player: A = rock; B = paper; C = scissors; 
-    // Second player: X = rock (1); Y = paper (2); Z = scissors (3); 
-    // Loss = 0; Draw = 3; Win = 6; 
-
-    int total_score{0}; 
-
-    auto calculate_match_result = [](char moveA, char moveB) -> char {
-        if (moveA == 'A') {
-            if (moveB == 'X') return 'D'; 
-            if (moveB == 'Y') return 'W'; 
-            if (moveB == 'Z') return 'L'; 
-        } 
-        
-        if (moveA == 'B') {
-            if (moveB == 'X') return 'L'; 
-            if (moveB == 'Y') return 'D'; 
-            if (moveB == 'Z') return 'W'; 
-        } 
-
-        // moveA == 'C'
-        if (moveB == 'X') return 'W'; 
-        if (moveB == 'Y') return 'L'; 
-        return 'D'; // moveB == 'Z'
-    }; 
-
-    std::unordered_map <char, int> move_points; 
-    std::unordered_map <char, int> match_points; 
-
-    move_points['X'] = 1; 
-    move_points['Y'] = 2; 
-    move_points['Z'] = 3; 
-    match_points['L'] = 0; 
-    match_points['D'] = 3; 
-    match_points['W'] = 6; 
-    
-    for (const auto& move: strategies) {
-        total_score += move_points[move.second]; 
-        auto match_result = calculate_match_result(move.first, move.second); 
-        total_score += match_points[match_result]; 
+long int calculate_score(const RoundCounts& round_counts, const ScoreTable& scores) {
+    long int total_score{0}; 
+    for (size_t i = 0; i < round_counts.size(); ++i) {
+        total_score += round_counts[i] * scores[i]; 
     }
-
     return total_score; 
 } 
 
-void solve_part_one(const std::vector<Move>& strategies) {
-    auto strategy_score = calculate_scores(strategies); 
-    std::cout << "The score for part one is " << strategy_score << std::endl; 
+void solve_part_one(const RoundCounts& round_counts) {
+    auto strategy_score = calculate_score(round_counts, PART_ONE_SCORES); 
+    aoc::out() << "The score for part one is " << strategy_score << std::endl; 
 }
 
-// For part two 
-// Convert the moves according to W-D-L to make it conformant 
-// to the algorithm of part one 
-auto convert_move(const std::vector<Move>& strategies) {
-    auto new_strategies = strategies;
-    
-    for (auto& s: new_strategies) {
-
-        if (s.first == 'A') {
-            if (s.second == 'X') s.second = 'Z';
-            else if (s.second == 'Y') s.second = 'X'; 
-            else if (s.second == 'Z') s.second = 'Y';  
-        } else if (s.first == 'B') {
-            if (s.second == 'X') s.second = 'X'; 
-            else if (s.second == 'Y') s.second = 'Y'; 
-            else if (s.second == 'Z') s.second = 'Z';             
-        } else if (s.first == 'C') {
-            if (s.second == 'X') s.second = 'Y'; 
-            else if (s.second == 'Y') s.second = 'Z'; 
-            else if (s.second == 'Z') s.second = 'X';  
-        }
-    }
-
-    return new_strategies; 
+// For part two the second column is the outcome of the round rather than a shape, which is 
+// already accounted for in the second table 
+void solve_part_two(const RoundCounts& round_counts) {
+    auto strategy_score = calculate_score(round_counts, PART_TWO_SCORES); 
+    aoc::out() << "The score for part two is " << strategy_score << std::endl; 
 }
 
-void solve_part_two(const std::vector<Move>& strategies) {
-    auto strategy_score = calculate_scores(convert_move(strategies)); 
-    std::cout << "The score for part two is " << strategy_score << std::endl; 
-}
\ No newline at end of file
+} // namespace day02
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day02::day, argc, argv); 
+}
+#endif
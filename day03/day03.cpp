@@ -1,12 +1,24 @@
 #include <iostream> 
 #include <string> 
+#include <string_view> 
 #include <vector> 
-#include <fstream>
-#include <utility> 
-#include <sstream> 
+#include <cstdint> 
 #include <stdlib.h>
 
-using Rucksack = std::pair<std::string, std::string>; 
+#include "day.h"
+#include "input.h"
+
+namespace day03 {
+
+// Approach: the 52 item types fit in a 64-bit mask, with bit p set if the item of priority p is present. 
+// Each compartment is turned into such a mask in a single pass over the input, so the item shared by the two 
+// compartments is the lowest bit of (A & B), and a group's badge is the lowest bit of the AND of the three 
+// rucksacks' masks (A | B). No strings are kept for the rucksacks. 
+
+using ItemMask = std::uint64_t; 
+struct Rucksack {
+    ItemMask first, second; // items of the two compartments 
+}; 
 
 constexpr const int LOWERCASE_SHIFT = 96; // 'a' = 97
 constexpr const int UPPERCASE_SHIFT = (65-27); // 'A' = 65
@@ -15,142 +27,102 @@ void get_data(const std::string&, std::vector<Rucksack>&);
 void solve_part_one(const std::vector<Rucksack>&); 
 void solve_part_two(const std::vector<Rucksack>&); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 3 <<<" << std::endl; 
+std::vector<Rucksack> rucksacks; 
+std::string input_file_name; 
 
-    std::string file_name{}; 
-    bool is_test{false}; 
-    std::vector<Rucksack> rucksacks; 
+void load(const std::string& file_name, bool) {
+    input_file_name = file_name; 
+    rucksacks.clear(); 
+    get_data(file_name, rucksacks); 
+}
 
-    if (argc > 1 && std::string{argv[1]} == "test") {
-        is_test = true; 
+// Only the item masks are kept, so the compartments are read again from the input 
+void print() {
+    aoc::InputFile input_file{input_file_name}; 
+    for (auto line: input_file.lines()) {
+        auto n = line.size(); 
+        aoc::out() << "compartment A: " << line.substr(0, n/2) << ", compartment B: " << line.substr(n/2) << std::endl;
     }
+}
 
-    if (is_test) {
-        file_name = "./test.txt"; 
-    } else {
-        file_name = "./input.txt";
-    }
+void part_one() { solve_part_one(rucksacks); }
+void part_two() { solve_part_two(rucksacks); }
 
-    get_data(file_name, rucksacks); 
+extern const aoc::Day day{3, load, print, part_one, part_two}; 
 
-    if (is_test) {
-        for (const auto& r: rucksacks) {
-            std::cout << "compartment A: " << r.first << ", compartment B: " << r.second << std::endl;
-        }
+// Priority of an item (1 to 52), or 0 for a byte which is not an item (e.g. the '\r' of a CRLF line) 
+int item_priority(char c) {
+    if (c >= 'a' && c <= 'z') return c - LOWERCASE_SHIFT; 
+    if (c >= 'A' && c <= 'Z') return c - UPPERCASE_SHIFT; 
+    return 0; 
+}
+
+auto to_item_mask(std::string_view items) {
+    ItemMask mask = 0; 
+    for (auto c: items) {
+        if (auto priority = item_priority(c)) mask |= ItemMask{1} << priority; 
     }
+    return mask; 
+}
 
-    solve_part_one(rucksacks); 
-    solve_part_two(rucksacks); 
+// Priority of the lowest item in the mask (0 if the mask is empty) 
+int lowest_priority(ItemMask mask) {
+    return mask ? __builtin_ctzll(mask) : 0; 
+}
 
+// Batch conversion of the whole input, one rucksack per line 
+void to_rucksacks(std::string_view text, std::vector<Rucksack>& rucksacks) {
+    for (auto line: aoc::lines(text)) {
+        auto n = line.size(); 
+        rucksacks.push_back({to_item_mask(line.substr(0, n/2)), to_item_mask(line.substr(n/2))}); 
+    }
 }
 
 void get_data(const std::string& file_name, std::vector<Rucksack>& rucksacks) {
 
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line{}; 
-        while (std::getline(input_file, line)) {
-            auto n = line.size(); 
-            auto compartmentA = line.substr(0, n/2); 
-            auto compartmentB = line.substr((n/2), (n - (n/2))); 
-            Rucksack rucksack(compartmentA, compartmentB); 
-            rucksacks.push_back(rucksack); 
-        }
+        to_rucksacks(input_file.text(), rucksacks); 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
-}
-
-// Approach: compare compartment A with compartment B char by char 
-// and stop when the common element is found. 
-// To speed up, a tmp stream 'unique_chars' keeps track of the visited elements 
-auto compare_compartments(const std::string& A, const std::string& B) {
-    std::ostringstream unique_chars;
-    int priority = 0; 
-
-    for (const auto& c: A) {
-        if (unique_chars.str().find(c) == std::string::npos) { 
-            if (B.find(c) != std::string::npos) {
-                priority = (c - 0 >= 96) ? c - LOWERCASE_SHIFT : c - UPPERCASE_SHIFT; 
-                break;
-            } 
-            unique_chars << c; 
-        }
-    } 
-    return priority; 
 }
 
 auto calculate_priorities(const std::vector<Rucksack>& rucksacks) {
     int total_priority = 0; 
     for (const auto& r: rucksacks) {
-        auto compartmentA = r.first; 
-        auto compartmentB = r.second; 
-        total_priority += compare_compartments(compartmentA, compartmentB); 
+        total_priority += lowest_priority(r.first & r.second); 
     }
     return total_priority; 
 }
 
 void solve_part_one(const std::vector<Rucksack>& rucksacks) {
     auto priority = calculate_priorities(rucksacks); 
-    std::cout << "The solution to part one is: " << priority << std::endl; 
-}
-
-// Approach: compare first vs. second and store the common chars in the common_badges stream 
-// Then, compare this partial result of 1 vs. 2 common badges with third 
-auto compare_group(const std::string& first, const std::string& second, const std::string& third) {
-    std::ostringstream unique_chars; 
-    std::ostringstream common_badges; 
-    int badge_priority = 0; 
-    for (const auto& c1: first) {
-        if (unique_chars.str().find(c1) == std::string::npos) {
-            if (second.find(c1) != std::string::npos) {
-                common_badges << c1; 
-            }
-            unique_chars << c1; 
-        }
-    }
-
-    // See https://stackoverflow.com/questions/5288036/how-to-clear-ostringstream#:~:text=str(%22%22)%3B%20s.,need%20to%20call%20clear()%20.
-    // for why we need both the following commands 
-    unique_chars.str(""); unique_chars.clear(); 
-
-    for (const auto& c2: common_badges.str()) {
-        if (unique_chars.str().find(c2) == std::string::npos) {
-            if (third.find(c2) != std::string::npos) {
-                badge_priority = (c2 - 0 >= 96) ? c2 - LOWERCASE_SHIFT : c2 - UPPERCASE_SHIFT;  
-                break; 
-            }
-            unique_chars << c2; 
-        }
-    }
-    return badge_priority; 
+    aoc::out() << "The solution to part one is: " << priority << std::endl; 
 }
 
+// The badge is the only item carried by all the three elves of a group 
 auto calculate_priorities_by_group(const std::vector<Rucksack>& rucksacks) {
     int total_priority = 0; 
-    int group_index = 0; 
-    std::string first, second, third; 
-
-    for (const auto& r: rucksacks) {
-        if (group_index == 0) first = r.first + r.second; 
-        else if (group_index == 1) second = r.first + r.second; 
-        else {
-            third = r.first + r.second; 
-            total_priority += compare_group(first, second, third); 
-            group_index = 0; 
-            continue; 
-        }
-        group_index += 1; 
+    for (size_t i = 0; i + 2 < rucksacks.size(); i += 3) {
+        ItemMask common = ~ItemMask{0}; 
+        for (size_t k = i; k < i + 3; ++k) common &= rucksacks[k].first | rucksacks[k].second; 
+        total_priority += lowest_priority(common); 
     }
     return total_priority; 
 }
 
 void solve_part_two(const std::vector<Rucksack>& rucksacks) {
     auto priority = calculate_priorities_by_group(rucksacks); 
-    std::cout << "The solution to part two is: " << priority << std::endl; 
-}
\ No newline at end of file
+    aoc::out() << "The solution to part two is: " << priority << std::endl; 
+}
+
+} // namespace day03
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day03::day, argc, argv); 
+}
+#endif
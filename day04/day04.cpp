@@ -1,140 +1,231 @@
 #include <iostream> 
 #include <vector> 
-#include <fstream>
 #include <string>
-#include <sstream>
+#include <algorithm>
 #include <cstdint> 
 #include <stdlib.h>
 
-struct Section {
-    uint16_t firstElfStart; 
-    uint16_t firstElfEnd; 
-    uint16_t secondElfStart; 
-    uint16_t secondElfEnd; 
+#include "day.h"
+#include "input.h"
 
-    Section(uint16_t fStart, uint16_t fEnd, uint16_t sStart, uint16_t sEnd): 
-        firstElfStart(fStart), firstElfEnd(fEnd), 
-            secondElfStart(sStart), secondElfEnd(sEnd) {}
+namespace day04 {
+
+// The assignments are stored as a structure of arrays (one array per field), so that the per-pair checks of 
+// the two parts are simple branch-free loops over contiguous uint16_t's, which the compiler can vectorize. 
+// On top of them, an AssignmentIndex answers queries over all the single elves' assignments of the roster: 
+// which of them overlap a given range, and how many pairs of them overlap (see below). 
+
+struct Sections {
+    std::vector<uint16_t> firstElfStart; 
+    std::vector<uint16_t> firstElfEnd; 
+    std::vector<uint16_t> secondElfStart; 
+    std::vector<uint16_t> secondElfEnd; 
+
+    void emplace_back(uint16_t fStart, uint16_t fEnd, uint16_t sStart, uint16_t sEnd) {
+        firstElfStart.push_back(fStart); 
+        firstElfEnd.push_back(fEnd); 
+        secondElfStart.push_back(sStart); 
+        secondElfEnd.push_back(sEnd); 
+    }
+
+    void clear() {
+        firstElfStart.clear(); firstElfEnd.clear(); secondElfStart.clear(); secondElfEnd.clear(); 
+    }
+
+    size_t size() const noexcept { return firstElfStart.size(); }
 }; 
 
-void get_data(const std::string&, std::vector<Section>&); 
-void solve_part_one(const std::vector<Section>&); 
-void solve_part_two(const std::vector<Section>&); 
+// A single elf's assignment [start, end], with its index in the roster (2 * pair + 0 or 1) 
+struct Assignment {
+    uint16_t start, end; 
+    uint32_t id; 
+}; 
 
-int main (int argc, char* argv[]) {
+// Interval index over the single assignments: the assignments are sorted by start, and an implicit balanced 
+// binary tree over the sorted array stores the maximum end of each subtree, so that the subtrees which cannot 
+// overlap a range are skipped. Sorted copies of the starts and of the ends give the counts in O(log n). 
+class AssignmentIndex {
 
-    std::cout << ">>> Advent Of Code 2022 - Day 4 <<<" << std::endl; 
+    std::vector<Assignment> by_start_; 
+    std::vector<uint16_t> max_end_;  // max end in the subtree rooted at each element of by_start_ 
+    std::vector<uint16_t> starts_, ends_;  // sorted 
 
-    std::string file_name; 
-    std::vector<Section> assignments; 
-    bool is_test = false; 
+    uint16_t build(size_t lo, size_t hi) {
+        if (lo >= hi) return 0; 
+        auto mid = lo + (hi - lo) / 2; 
+        max_end_[mid] = std::max({by_start_[mid].end, build(lo, mid), build(mid + 1, hi)}); 
+        return max_end_[mid]; 
+    }
+
+    void collect(size_t lo, size_t hi, uint16_t start, uint16_t end, std::vector<uint32_t>& ids) const {
+        if (lo >= hi) return; 
+        auto mid = lo + (hi - lo) / 2; 
+        if (max_end_[mid] < start) return;  // everything in this subtree ends before the range 
+        collect(lo, mid, start, end, ids); 
+        if (by_start_[mid].start > end) return;  // this one and the right subtree start after the range 
+        if (by_start_[mid].end >= start) ids.push_back(by_start_[mid].id); 
+        collect(mid + 1, hi, start, end, ids); 
+    }
 
-    if (argc > 1 && std::string(argv[1]) == "test") {
-        is_test = true; 
+    public: 
+    explicit AssignmentIndex(const Sections& sections) {
+        for (size_t i = 0; i < sections.size(); ++i) {
+            by_start_.push_back({sections.firstElfStart[i], sections.firstElfEnd[i], static_cast<uint32_t>(2 * i)}); 
+            by_start_.push_back({sections.secondElfStart[i], sections.secondElfEnd[i], static_cast<uint32_t>(2 * i + 1)}); 
+        }
+        std::sort(by_start_.begin(), by_start_.end(), [](const Assignment& a1, const Assignment& a2) {
+            return a1.start < a2.start || (a1.start == a2.start && a1.id < a2.id); 
+        }); 
+        max_end_.resize(by_start_.size()); 
+        build(0, by_start_.size()); 
+
+        for (const auto& a: by_start_) {
+            starts_.push_back(a.start); 
+            ends_.push_back(a.end); 
+        }
+        std::sort(ends_.begin(), ends_.end()); 
     }
 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+    // Ids of the assignments overlapping [start, end]: O(log n + k) for k assignments found 
+    std::vector<uint32_t> overlapping(uint16_t start, uint16_t end) const {
+        std::vector<uint32_t> ids; 
+        collect(0, by_start_.size(), start, end, ids); 
+        return ids; 
+    }
 
-    get_data(file_name, assignments);
+    // Number of assignments overlapping [start, end]: all of them, but those ending before the start 
+    // and those starting after the end 
+    size_t count_overlapping(uint16_t start, uint16_t end) const {
+        auto n_before = std::lower_bound(ends_.begin(), ends_.end(), start) - ends_.begin(); 
+        auto n_after = starts_.end() - std::upper_bound(starts_.begin(), starts_.end(), end); 
+        return by_start_.size() - n_before - n_after; 
+    }
 
-    if (is_test) {
-        for (const auto& a: assignments) {
-            std::cout << "First elf start: " << a.firstElfStart << ", first elf end: " <<
-            a.firstElfEnd << " // Second elf start: " << a.secondElfStart << ", second elf end: " <<
-            a.secondElfEnd <<  "\n" << 
-            "-----------------------------------------------------------------------------" << std::endl; 
+    // Number of pairs of assignments (in the whole roster) which overlap: sweeping the assignments by start, 
+    // each one overlaps all the previous ones except those which end before it starts 
+    size_t count_overlapping_pairs() const {
+        size_t count = 0; 
+        for (size_t i = 0; i < by_start_.size(); ++i) {
+            auto n_ended = std::lower_bound(ends_.begin(), ends_.end(), by_start_[i].start) - ends_.begin(); 
+            count += i - n_ended; 
         }
+        return count; 
     }
+}; 
 
-    solve_part_one(assignments); 
-    solve_part_two(assignments); 
+void get_data(const std::string&, Sections&); 
+void solve_part_one(const Sections&); 
+void solve_part_two(const Sections&); 
+void query_roster(const Sections&, uint16_t, uint16_t); 
 
+Sections assignments; 
 
+// Range of the roster query ("--query START-END" on the command line), if any 
+bool has_query{false}; 
+uint16_t query_start{0}, query_end{0}; 
+
+void load(const std::string& file_name, bool) {
+    assignments.clear(); 
+    get_data(file_name, assignments); 
 }
 
-void get_data(const std::string& file_name, std::vector<Section>& assignments) {
+void print() {
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        aoc::out() << "First elf start: " << assignments.firstElfStart[i] << ", first elf end: " <<
+        assignments.firstElfEnd[i] << " // Second elf start: " << assignments.secondElfStart[i] << ", second elf end: " <<
+        assignments.secondElfEnd[i] <<  "\n" << 
+        "-----------------------------------------------------------------------------" << std::endl; 
+    }
+}
 
-    std::ifstream input_file(file_name); 
+void part_one() { solve_part_one(assignments); }
+void part_two() { 
+    solve_part_two(assignments); 
+    if (has_query) query_roster(assignments, query_start, query_end); 
+}
+
+// "--query START-END" also lists the assignments overlapping the range 
+void set_query(std::string_view range) {
+    query_start = aoc::to_int<uint16_t>(aoc::next_field(range, '-')); 
+    query_end = aoc::to_int<uint16_t>(range); 
+    has_query = true; 
+}
+
+extern const aoc::Day day{4, load, print, part_one, part_two, {
+    {"--query", true, set_query}
+}}; 
+
+void get_data(const std::string& file_name, Sections& assignments) {
+
+    aoc::InputFile input_file(file_name); 
 
     if (input_file.is_open()) {
-        std::string line; 
-        std::string elves; 
-        std::istringstream elf_stream;  
-        while (std::getline(input_file, line)) {
-            std::istringstream line_stream{line};
-            std::vector<uint16_t> input_assignments;
-            input_assignments.reserve(4);  
-            uint16_t elfStart, elfEnd;
-            while (std::getline(line_stream,  elves, ',')) {
-                std::istringstream elf_stream{elves};
-                elf_stream >> elfStart; 
-                elf_stream.ignore(); 
-                elf_stream >> elfEnd; 
-                input_assignments.push_back(elfStart);
-                input_assignments.push_back(elfEnd); 
-            }
-            assignments.emplace_back(input_assignments[0], input_assignments[1], input_assignments[2], input_assignments[3]);
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            // Each line is "<start>-<end>,<start>-<end>" 
+            auto first_elf = aoc::next_field(line, ','); 
+            auto firstElfStart = aoc::to_int<uint16_t>(aoc::next_field(first_elf, '-')); 
+            auto firstElfEnd = aoc::to_int<uint16_t>(first_elf); 
+            auto secondElfStart = aoc::to_int<uint16_t>(aoc::next_field(line, '-')); 
+            auto secondElfEnd = aoc::to_int<uint16_t>(line); 
+            assignments.emplace_back(firstElfStart, firstElfEnd, secondElfStart, secondElfEnd);
         }
 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-
-    input_file.close(); 
 } 
 
-auto assignments_is_contained(const Section& section) {
-    auto first_elf_range = section.firstElfEnd - section.firstElfStart; 
-    auto second_elf_range = section.secondElfEnd - section.secondElfStart; 
-
-    if (first_elf_range > second_elf_range) {
-        return section.firstElfStart <= section.secondElfStart && 
-                section.firstElfEnd >= section.secondElfEnd; 
-    }
-    
-    return section.secondElfStart <= section.firstElfStart && 
-                section.secondElfEnd >= section.firstElfEnd;  
-}
-
-auto count_containing_assignments(const std::vector<Section>& assignments) {
+// One of the two assignments fully contains the other 
+auto count_containing_assignments(const Sections& assignments) {
+    const auto* fs = assignments.firstElfStart.data(); 
+    const auto* fe = assignments.firstElfEnd.data(); 
+    const auto* ss = assignments.secondElfStart.data(); 
+    const auto* se = assignments.secondElfEnd.data(); 
     int count = 0; 
-    for (const auto& a: assignments) {
-        count += assignments_is_contained(a); 
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        count += (fs[i] <= ss[i] && fe[i] >= se[i]) | (ss[i] <= fs[i] && se[i] >= fe[i]); 
     }
     return count; 
 }
 
-void solve_part_one(const std::vector<Section>& assignments) {
+void solve_part_one(const Sections& assignments) {
     auto count = count_containing_assignments(assignments); 
-    std::cout << "The solution to part one is: " << count << std::endl; 
+    aoc::out() << "The solution to part one is: " << count << std::endl; 
 }
 
-auto assignment_is_overlapping(const Section& section) {
-
-    if (section.firstElfStart < section.secondElfStart) {
-        return section.secondElfStart <= section.firstElfEnd;
-    } 
-
-    if (section.secondElfStart < section.firstElfStart) {
-        return section.firstElfStart <= section.secondElfEnd; 
+// Two assignments overlap if each one starts before the other one ends 
+auto count_overlapping_assignments(const Sections& assignments) {
+    const auto* fs = assignments.firstElfStart.data(); 
+    const auto* fe = assignments.firstElfEnd.data(); 
+    const auto* ss = assignments.secondElfStart.data(); 
+    const auto* se = assignments.secondElfEnd.data(); 
+    int count = 0; 
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        count += (fs[i] <= se[i]) & (ss[i] <= fe[i]); 
     }
+    return count; 
+}
 
-    // the base condition is when the two assignments begin at the same slot
-    // in which case the overlap is automatically true
-    return true; 
+void solve_part_two(const Sections& assignments) {
+    auto count = count_overlapping_assignments(assignments); 
+    aoc::out() << "The solution to part two is: " << count << std::endl; 
 }
 
-auto count_overlapping_assignments(const std::vector<Section>& assignments) {
-    int count = 0; 
-    for (const auto& a: assignments) {
-        count += assignment_is_overlapping(a); 
+void query_roster(const Sections& assignments, uint16_t start, uint16_t end) {
+    AssignmentIndex index(assignments); 
+    aoc::out() << "Assignments overlapping " << start << "-" << end << ": " << index.count_overlapping(start, end) << std::endl; 
+    for (auto id: index.overlapping(start, end)) {
+        aoc::out() << "  line " << id / 2 + 1 << ", elf " << id % 2 + 1 << std::endl; 
     }
-    return count; 
+    aoc::out() << "Overlapping pairs of assignments in the roster: " << index.count_overlapping_pairs() << std::endl; 
 }
 
-void solve_part_two(const std::vector<Section>& assignments) {
-    auto count = count_overlapping_assignments(assignments); 
-    std::cout << "The solution to part two is: " << count << std::endl; 
-}
\ No newline at end of file
+} // namespace day04
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day04::day, argc, argv); 
+}
+#endif
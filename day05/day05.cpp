@@ -2,10 +2,20 @@
 #include <string>
 #include <vector>
 #include <sstream>
-#include <fstream> 
+#include <algorithm>
+#include <iterator>
 #include <cstdint> 
 #include <stdlib.h>
 
+#include "day.h"
+#include "input.h"
+
+namespace day05 {
+
+// Each stack is stored as a string of crates from the bottom to the top, so that the top of the stack is at the 
+// end of the string: moving n crates is then a single block copy appended to the destination, plus a resize 
+// of the source, and costs O(n) whatever the height of the stacks. 
+
 struct Move {
     uint16_t size; 
     uint16_t from; 
@@ -18,57 +28,44 @@ void get_data(const std::string&, std::vector<std::string>&, std::vector<Move>&)
 void solve_part_one(const std::vector<std::string>&, const std::vector<Move>&); 
 void solve_part_two(const std::vector<std::string>&, const std::vector<Move>&); 
 
-int main (int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 5 <<<" << std::endl; 
-
-    std::string file_name{}; 
-    std::vector<std::string> stacks; 
-    std::vector<Move> moves; 
-    bool is_test{false}; 
-
-    if (argc > 1 && std::string(argv[1]) == "test") {
-        is_test = true; 
-    }
-
-    if (is_test) {
-        file_name = "./test.txt"; 
-    } else {
-        file_name = "./input.txt"; 
-    }
+std::vector<std::string> stacks; 
+std::vector<Move> moves; 
 
+void load(const std::string& file_name, bool) {
+    stacks.clear(); 
+    moves.clear(); 
     get_data(file_name, stacks, moves); 
+}
 
-    if (is_test) {
-        std::cout << "INITIAL STACK: " << std::endl; 
-        for (const auto& s: stacks) {
-            std::cout << s << std::endl; 
-        }
-        std::cout << "-------------------------------" << std::endl; 
-        std::cout << "MOVES: " << std::endl; 
-        for (const auto& m: moves) {
-            std::cout << "Size:" << m.size << ", from: " << m.from << ", to: " << m.to << std::endl; 
-        }
-        std::cout << "-------------------------------" << std::endl; 
+void print() {
+    aoc::out() << "INITIAL STACK: " << std::endl; 
+    for (const auto& s: stacks) {
+        aoc::out() << std::string(s.rbegin(), s.rend()) << std::endl;  // from the top 
     }
+    aoc::out() << "-------------------------------" << std::endl; 
+    aoc::out() << "MOVES: " << std::endl; 
+    for (const auto& m: moves) {
+        aoc::out() << "Size:" << m.size << ", from: " << m.from << ", to: " << m.to << std::endl; 
+    }
+    aoc::out() << "-------------------------------" << std::endl; 
+}
 
-    solve_part_one(stacks, moves); 
-    solve_part_two(stacks, moves); 
+void part_one() { solve_part_one(stacks, moves); }
+void part_two() { solve_part_two(stacks, moves); }
 
-}
+extern const aoc::Day day{5, load, print, part_one, part_two}; 
 
 void get_data(const std::string& file_name, std::vector<std::string>& stacks,
                 std::vector<Move>& moves) {
 
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
         bool getting_configurations{true}; 
         
-        while (std::getline(input_file, line)) {
+        for (auto line: input_file.lines()) {
             auto n = line.size(); 
-            if (n > 0 && line.at(1) == '1' ) {
+            if (n > 1 && line[1] == '1' ) {
                 getting_configurations = false; 
                 continue; 
             }
@@ -94,16 +91,11 @@ void get_data(const std::string& file_name, std::vector<std::string>& stacks,
                     crate_it++; 
                 }
             } 
-            else {      // Part 2: get moves 
-                std::istringstream move_stream{line}; 
-                std::string to_ignore{}; 
-                uint16_t size, from, to; 
-                move_stream >> to_ignore; // "move"
-                move_stream >> size; 
-                move_stream >> to_ignore; // "from"
-                move_stream >> from; 
-                move_stream >> to_ignore; // "to"
-                move_stream >> to; 
+            else {      // Part 2: get moves ("move <size> from <from> to <to>")
+                uint16_t size{0}, from{0}, to{0}; 
+                // A line with a missing or non-numeric field (or a stack 0) is not a move 
+                if (!aoc::next_int(line, size) || !aoc::next_int(line, from) || !aoc::next_int(line, to)) continue; 
+                if (from == 0 || to == 0) continue; 
                 moves.emplace_back(size, from-1, to-1); // Subtract 1 to conform to c++ indexing 
             }          
         }
@@ -111,41 +103,48 @@ void get_data(const std::string& file_name, std::vector<std::string>& stacks,
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
+
+    // The drawing lists the crates from the top down 
+    for (auto& s: stacks) std::reverse(s.begin(), s.end()); 
 }
 
 // Note: stacks is passed-by-valued as we need fresh input data for part two 
 auto move_crates(std::vector<std::string> stacks, const std::vector<Move>& moves, bool part_one=true) {
     std::ostringstream answer; 
     for (const auto& move: moves) {
-        const auto& size = move.size; 
-        const auto& from = move.from; 
-        const auto& to = move.to; 
-        auto& source_crate = stacks.at(static_cast<size_t>(from)); 
-        auto& destination_crate = stacks.at(static_cast<size_t>(to)); 
-        auto moved_part = source_crate.substr(0, size); 
-        source_crate = source_crate.substr(size, source_crate.size()); 
+        if (move.from == move.to) continue;  // moving crates onto their own stack changes nothing 
+        auto& source_crate = stacks.at(static_cast<size_t>(move.from)); 
+        auto& destination_crate = stacks.at(static_cast<size_t>(move.to)); 
+        size_t size = std::min<size_t>(move.size, source_crate.size()); 
+        auto moved_part = source_crate.end() - size; 
         if (part_one) { // Part one: reversed order (one item at a time)
-            for (auto& c: moved_part) {
-                destination_crate = c + destination_crate; 
-            }
+            destination_crate.append(std::make_reverse_iterator(source_crate.end()), std::make_reverse_iterator(moved_part)); 
         } 
         else {  // Part two: order is preserved
-            destination_crate = moved_part + destination_crate; 
+            destination_crate.append(moved_part, source_crate.end()); 
         }
+        source_crate.resize(source_crate.size() - size); 
     }
     for (const auto& s: stacks) {
-        answer << s.at(0); 
+        if (!s.empty()) answer << s.back(); 
     }
     return answer.str(); 
 }
 
 void solve_part_one(const std::vector<std::string>& stacks, const std::vector<Move>& moves) {
     auto answer = move_crates(stacks, moves); 
-    std::cout << "The solution to part one is: " << answer << std::endl; 
+    aoc::out() << "The solution to part one is: " << answer << std::endl; 
 }
 
 void solve_part_two(const std::vector<std::string>& stacks, const std::vector<Move>& moves) {
     auto answer = move_crates(stacks, moves, false); 
-    std::cout << "The solution to part two is: " << answer << std::endl; 
+    aoc::out() << "The solution to part two is: " << answer << std::endl; 
+}
+
+} // namespace day05
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day05::day, argc, argv); 
 }
+#endif
@@ -2,56 +2,50 @@
 #include <iostream>
 #include <cstdint>
 #include <stdlib.h>
-#include <sstream> 
-#include <fstream> 
 #include <vector> 
+#include <array> 
+#include <algorithm> 
+#include <string_view> 
+#include <cstring> 
+#include <cerrno> 
+#include <unistd.h> 
+
+#include "day.h"
+#include "input.h"
+
+namespace day06 {
 
 void get_data(const std::string&, std::vector<std::string>&); 
 void solve_part_one(const std::vector<std::string>&, bool);
 void solve_part_two(const std::vector<std::string>&, bool); 
 
-int main(int argc, char** argv) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 6 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test = false; 
-    std::vector<std::string> datastreams; // A vector ain't really necessary here, but the test consists of several strings
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-
-    if (is_test) {
-        file_name = "./test.txt"; 
-        datastreams.reserve(4); // 4 test cases
-    }
-    else {
-        file_name = "./input.txt"; 
-        datastreams.reserve(1); 
-    }
+bool is_test = false; 
+std::vector<std::string> datastreams; // A vector ain't really necessary here, but the test consists of several strings
 
+void load(const std::string& file_name, bool test) {
+    is_test = test; 
+    datastreams.clear(); 
     get_data(file_name, datastreams); 
+}
 
-    if (is_test) {
-        for (const auto& d: datastreams) {
-            std::cout << d << std::endl; 
-        }
+void print() {
+    for (const auto& d: datastreams) {
+        aoc::out() << d << std::endl; 
     }
+}
 
-    solve_part_one(datastreams, is_test); 
-    solve_part_two(datastreams, is_test); 
+void part_one() { solve_part_one(datastreams, is_test); }
+void part_two() { solve_part_two(datastreams, is_test); }
 
-    return 0; 
-}
+extern const aoc::Day day{6, load, print, part_one, part_two}; 
 
 void get_data(const std::string& file_name, std::vector<std::string>& datastreams) {
 
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string datastream; 
-
-        while (std::getline(input_file, datastream)) {
-            datastreams.push_back(datastream);
+        for (auto datastream: input_file.lines()) {
+            datastreams.emplace_back(datastream);
         } 
     } 
     else {
@@ -59,54 +53,88 @@ void get_data(const std::string& file_name, std::vector<std::string>& datastream
         exit(0); 
     }
 
-    input_file.close(); 
-
 }
 
-// Approach: set a target difference (3 in case of part 1, given by 4 distinct characters -1 
-// as we are also counting 0, and 13 in case of part 2 )
-// Then loop through the string with two pointers: if they don't match, increase the 
-// second pointer until their difference reaches the value of target_difference; 
-// then increase the first pointer by 1, decrease the second pointer to index1 + 1 
-// and continue the comparison, this time decreasing the target difference. 
-// If the target difference reaches 0, return the second pointer. Else, if the two 
-// characters match, reset the target difference and place the two pointers in such a way
-// to compare a new string 
-auto find_marker_index(const std::string& datastream, const size_t n_distinct_characters=4) {
-    uint16_t move{0};
-    size_t index1 = 0; 
-    size_t index2 = 1; 
-    size_t target_difference = n_distinct_characters - 1;
-
-	while (target_difference > 0 && index2 < datastream.size()) {
-		auto diff = index2 - index1; 
-		if (datastream.at(index1) != datastream.at(index2)) {
-			if (diff == target_difference) {
-				target_difference --; 
-				index1 ++;
-				index2 = index1 + 1; 
-			} else {
-				index2 ++; 
-			}
-		} else {
-			target_difference = n_distinct_characters - 1; 
-			index1 ++; 
-            index2 = index1 + 1; 
+// Approach: a single pass through the datastream, keeping for every character the last position where it was 
+// seen. The characters since the last repetition (i.e. after the last seen position of any character in the 
+// current run) are all distinct: as soon as this run is w characters long, the marker of window size w is found. 
+// This is O(n) whatever the window size, and several window sizes are answered in the same pass (a run of 
+// w distinct characters contains all the shorter ones, so the markers are found in increasing window size). 
+// The state is kept between calls to feed(), so the datastream can be processed in chunks as it arrives. 
+class MarkerDetector {
+
+    std::vector<size_t> window_sizes_;  // sorted 
+    std::vector<size_t> markers_;       // 0 until found 
+    size_t n_found_{0}; 
+    std::array<size_t, 256> next_after_last_seen_{};  // position after the last occurrence of each character 
+    size_t run_start_{0};  // start of the current run of distinct characters 
+    size_t position_{0};   // number of characters processed so far 
+
+    public: 
+    explicit MarkerDetector(std::vector<size_t> window_sizes): window_sizes_(std::move(window_sizes)) {
+        std::sort(window_sizes_.begin(), window_sizes_.end()); 
+        markers_.assign(window_sizes_.size(), 0); 
+    }
+
+    // Processes the next chunk of the datastream 
+    void feed(std::string_view chunk) {
+        for (auto c: chunk) {
+            if (done()) return; 
+            auto& next_after_last = next_after_last_seen_[static_cast<unsigned char>(c)]; 
+            run_start_ = std::max(run_start_, next_after_last); 
+            next_after_last = ++position_; 
+            while (n_found_ < window_sizes_.size() && position_ - run_start_ >= window_sizes_[n_found_]) {
+                markers_[n_found_++] = position_; 
+            }
         }
-	}
-	return index2; 
+    }
+
+    bool done() const noexcept { return n_found_ == window_sizes_.size(); }
+
+    // Number of characters processed when the marker of the given window size was found (0 if not found) 
+    size_t marker(size_t window_size) const {
+        auto it = std::find(window_sizes_.begin(), window_sizes_.end(), window_size); 
+        return it == window_sizes_.end() ? 0 : markers_[it - window_sizes_.begin()]; 
+    }
+}; 
+
+auto find_marker_index(const std::string& datastream, const size_t n_distinct_characters=4) {
+    MarkerDetector detector({n_distinct_characters}); 
+    detector.feed(datastream); 
+    return detector.marker(n_distinct_characters); 
+}
+
+// Reads a datastream from a file descriptor (e.g. a pipe) as it arrives, and prints the markers of the given 
+// window sizes. Every read returns whatever data is available (up to a chunk), rather than waiting for a full 
+// chunk, so the markers are found as soon as the characters which complete them arrive 
+void find_markers_in_stream(int fd, const std::vector<size_t>& window_sizes) {
+    MarkerDetector detector(window_sizes); 
+    std::vector<char> chunk(1 << 16); 
+    while (!detector.done()) {
+        auto n_read = ::read(fd, chunk.data(), chunk.size()); 
+        if (n_read < 0 && errno == EINTR) continue; 
+        if (n_read <= 0) break; 
+        std::string_view data(chunk.data(), static_cast<size_t>(n_read)); 
+        // Only the first line of the stream is the datastream 
+        auto end_of_line = data.find('\n'); 
+        detector.feed(data.substr(0, end_of_line)); 
+        if (end_of_line != std::string_view::npos) break; 
+    }
+    for (auto w: window_sizes) {
+        aoc::out() << "Marker of " << w << " distinct characters: " << detector.marker(w) << std::endl; 
+    }
 }
 
 void solve_part_one(const std::vector<std::string>& datastreams, bool is_test) {
     if (!is_test) {
         auto marker_index = find_marker_index(datastreams.at(0)); 
-        std::cout << "The solution to part one is " << marker_index << std::endl; 
+        aoc::out() << "The solution to part one is " << marker_index << std::endl; 
     } 
     else {
         size_t i = 0; 
         for (const auto& s: datastreams) {
             auto marker_index = find_marker_index(s); 
-            std::cout << "The solution to part one (test " << i << ") is " << marker_index << std::endl; 
+            aoc::out() << "The solution to part one (test " << i << ") is " << marker_index << std::endl; 
             i++; 
         }
     }
@@ -115,17 +143,31 @@ void solve_part_one(const std::vector<std::string>& datastreams, bool is_test) {
 void solve_part_two(const std::vector<std::string>& datastreams, bool is_test) {
     if (!is_test) {
         auto marker_index = find_marker_index(datastreams.at(0), 14); 
-        std::cout << "The solution to part two is " << marker_index << std::endl; 
+        aoc::out() << "The solution to part two is " << marker_index << std::endl; 
     } 
     else {
         size_t i = 0; 
         for (const auto& s: datastreams) {
             auto marker_index = find_marker_index(s, 14); 
-            std::cout << "The solution to part two (test " << i << ") is " << marker_index << std::endl; 
+            aoc::out() << "The solution to part two (test " << i << ") is " << marker_index << std::endl; 
             i++; 
         }
     }
 }
 
-
-
+} // namespace day06
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    // "--stdin [W...]" reads the datastream from the standard input as it arrives, and finds the markers of 
+    // the given window sizes (default: 4 and 14) 
+    if (argc > 1 && std::strcmp(argv[1], "--stdin") == 0) {
+        std::vector<size_t> window_sizes; 
+        for (int i = 2; i < argc; ++i) window_sizes.push_back(aoc::to_int<size_t>(argv[i])); 
+        if (window_sizes.empty()) window_sizes = {4, 14}; 
+        day06::find_markers_in_stream(STDIN_FILENO, window_sizes); 
+        return 0; 
+    }
+    return aoc::run_day(day06::day, argc, argv); 
+}
+#endif
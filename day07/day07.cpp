@@ -1,149 +1,169 @@
 #include <iostream> 
-#include <fstream> 
 #include <string> 
+#include <string_view>
 #include <vector> 
-#include <memory> 
+#include <deque> 
 #include <sstream> 
-#include <map> 
+#include <unordered_map> 
+#include <cstdint> 
 
-using file = std::pair<size_t, std::string>; 
+#include "day.h"
+#include "input.h"
 
-// The following class aims at representing a pc's folders. 
-class folder {
-	folder* parent = nullptr; 
-	std::vector<std::unique_ptr<folder>> subfolders; 
-	std::vector<file> files; 
+namespace day07 {
 
-	public: 
-	std::string name;
-	folder() = default; 
+// The file system is stored in flat arrays indexed by folder (and file) number, rather than as a tree of 
+// objects: each folder knows its parent, its first child and its next sibling, and its total size. Names are 
+// interned, so every distinct name is stored once and folders and files only refer to it by number. The total 
+// sizes are propagated up the parent chain as soon as a file is listed, so that once the transcript is parsed 
+// both answers come from a single linear scan over the sizes, without any recursion. 
 
-	folder(std::string&& n) : name(std::move(n)) {}
+constexpr size_t NONE = static_cast<size_t>(-1); 
 
-	auto get_parent() {
-		if (this->name == "/") return this; 
-		return this->parent; 
-	}
+struct folder {
+	size_t parent; 
+	size_t name; 
+	size_t first_subfolder = NONE, last_subfolder = NONE, next_sibling = NONE; 
+	size_t first_file = NONE, last_file = NONE; 
+	size_t size = 0;  // total size, including the subfolders 
+}; 
+
+struct file {
+	size_t size; 
+	size_t name; 
+	size_t next_file = NONE; 
+}; 
 
-	void set_parent(folder* parent_folder) {
-		if (this->name == "/") return; // "/" cannot have a parent 
-		if (parent == nullptr) this->parent = parent_folder;
+class file_system_t {
+	std::deque<std::string> names;  // interned names (a deque never moves its elements) 
+	std::unordered_map<std::string_view, size_t> name_ids; 
+	std::unordered_map<std::uint64_t, size_t> subfolder_ids;  // (parent, name) -> subfolder 
+
+	static std::uint64_t subfolder_key(size_t parent, size_t name) {
+		return (static_cast<std::uint64_t>(parent) << 32) ^ name; 
 	}
-	
-	void add_subfolder(std::unique_ptr<folder>& sub_folder) {
-		this->subfolders.push_back(std::move(sub_folder)); 
+
+	public: 
+	std::vector<folder> folders;  // folders[0] is "/" 
+	std::vector<file> files; 
+
+	file_system_t() { clear(); }
+
+	void clear() {
+		names.clear(); name_ids.clear(); subfolder_ids.clear(); folders.clear(); files.clear(); 
+		folders.push_back(folder{0, intern("/")}); 
 	}
-	
-	// void add_subfolder(std::string& sub_folder_name) {
-	// 	this->subfolders.emplace_back(std::make_unique<folder>(std::move(sub_folder_name))); 
-	// }
-
-	const std::vector<folder*> get_subfolders() const {
-		std::vector<folder*> result;
-		for (const auto& subfolder : subfolders) {
-			result.push_back(subfolder.get());
-		}
-		return result;
+
+	size_t intern(std::string_view name) {
+		auto it = name_ids.find(name); 
+		if (it != name_ids.end()) return it->second; 
+		names.emplace_back(name); 
+		name_ids.emplace(names.back(), names.size() - 1); 
+		return names.size() - 1; 
 	}
 
-	void add_file(const size_t size, std::string& file_name) {
-		this->files.emplace_back(file{size, file_name}); 
+	const std::string& name(size_t id) const { return names[id]; }
+
+	size_t find_subfolder(size_t parent, std::string_view name) const {
+		auto name_it = name_ids.find(name); 
+		if (name_it == name_ids.end()) return NONE; 
+		auto it = subfolder_ids.find(subfolder_key(parent, name_it->second)); 
+		return it == subfolder_ids.end() ? NONE : it->second; 
 	}
 
-	std::vector<file> get_files() const {
-		return this->files; 
+	size_t add_subfolder(size_t parent, std::string_view name) {
+		auto existing = find_subfolder(parent, name); 
+		if (existing != NONE) return existing; 
+		auto id = folders.size(); 
+		auto name_id = intern(name); 
+		folders.push_back(folder{parent, name_id}); 
+		subfolder_ids.emplace(subfolder_key(parent, name_id), id); 
+		auto& p = folders[parent]; 
+		if (p.last_subfolder == NONE) p.first_subfolder = id; 
+		else folders[p.last_subfolder].next_sibling = id; 
+		p.last_subfolder = id; 
+		return id; 
 	}
 
-	folder* find_subfolder(const std::string& sub_folder_name) const {
-		for (auto& s: this->subfolders) {
-			if (s->name == sub_folder_name) {
-				return s.get();  // equivalent: return &*s;  
-				// If return type is folder& : return *s; 
-			}
+	void add_file(size_t parent, size_t size, std::string_view name) {
+		auto id = files.size(); 
+		files.push_back(file{size, intern(name)}); 
+		auto& p = folders[parent]; 
+		if (p.last_file == NONE) p.first_file = id; 
+		else files[p.last_file].next_file = id; 
+		p.last_file = id; 
+
+		// Roll the size up to all the ancestors 
+		for (auto f = parent; ; f = folders[f].parent) {
+			folders[f].size += size; 
+			if (f == 0) break; 
 		}
-		return nullptr; 
 	}
 
-	std::string scan_folder(unsigned int level=0) const {
+	std::string scan_folder(size_t id = 0, unsigned int level=0) const {
 		std::ostringstream folder_scanner{""};  
 		auto prefix = std::string(level * 2, ' ') + (level > 0 ?  "- " : "");  
-		folder_scanner << prefix  << this->name << " (dir)\n"; 
-		if (this->subfolders.size() > 0) {
-			for (const auto& s: subfolders) {
-				folder_scanner << s->scan_folder(level + 1); 
-			}
+		folder_scanner << prefix << name(folders[id].name) << " (dir)\n"; 
+		for (auto s = folders[id].first_subfolder; s != NONE; s = folders[s].next_sibling) {
+			folder_scanner << scan_folder(s, level + 1); 
 		}
-		if (this->files.size() > 0) {
-			auto file_prefix = std::string(level + 1, ' ') + (level == 0 ? " - " : prefix); 
-			for (const auto& f: files) {
-				folder_scanner << file_prefix << f.second << " (file, " << f.first << ")" "\n";  
-			}
+		auto file_prefix = std::string(level + 1, ' ') + (level == 0 ? " - " : prefix); 
+		for (auto f = folders[id].first_file; f != NONE; f = files[f].next_file) {
+			folder_scanner << file_prefix << name(files[f].name) << " (file, " << files[f].size << ")" "\n";  
 		}
 		return folder_scanner.str();  
 	}
 }; 
 
-folder get_data(const std::string&); 
-void solve_part_one(const folder&); 
-void solve_part_two(const folder&); 
+void get_data(const std::string&, file_system_t&); 
+void solve_part_one(const file_system_t&); 
+void solve_part_two(const file_system_t&); 
 
-int main(int argc, char* argv[]) {
-	std::cout << ">>> Advent Of Code 2022 - Day 7 <<<" << std::endl; 
+file_system_t file_system; 
 
-    std::string file_name; 
-    bool is_test = false;  
+void load(const std::string& file_name, bool) {
+	file_system.clear(); 
+	get_data(file_name, file_system); 
+}
 
-	if (argc > 1 && std::string(argv[1]) == "test") {is_test = true;}
+void print() {
+	aoc::out() << file_system.scan_folder() << std::endl; 
+}
 
-	if (is_test) file_name = "./test.txt"; 
-	else file_name = "./input.txt";
+void part_one() { solve_part_one(file_system); }
+void part_two() { solve_part_two(file_system); }
 
-	auto file_system = get_data(file_name); 
-	if (is_test) {
-		std::cout << file_system.scan_folder() << std::endl; 
-	}
+extern const aoc::Day day{7, load, print, part_one, part_two}; 
 
-	solve_part_one(file_system); 
-    solve_part_two(file_system); 
-}
-
-folder get_data(const std::string& file_name) {
+void get_data(const std::string& file_name, file_system_t& file_system) {
 
-	std::ifstream input_file{file_name};  
-	folder file_system("/"); 
+	aoc::InputFile input_file{file_name};  
 
 	if (input_file.is_open()) {
-		std::string line; 
-		folder* current_folder = &file_system; 
+		size_t current_folder = 0; 
 
-		while(std::getline(input_file, line)) {
-			std::istringstream line_stream(line); 
-			std::string next_token; 
-			line_stream >> next_token; 
+		for (auto line: input_file.lines()) {
+			auto next_token = aoc::next_field(line); 
 			if (next_token == "$") {
-				line_stream >> next_token; 
+				next_token = aoc::next_field(line); 
 				if (next_token == "cd") {
-					line_stream >> next_token; 
+					next_token = aoc::next_field(line); // subfolder name after "cd"
 					if (next_token == "..") {
-						current_folder = current_folder->get_parent(); 
-					}
-					else {
-						line_stream >> next_token; // subfolder name after "cd"
-						auto tmp_folder = current_folder->find_subfolder(next_token);
-						if (tmp_folder) current_folder = tmp_folder; 
+						current_folder = file_system.folders[current_folder].parent; 
+					} else if (next_token == "/") {
+						current_folder = 0; 
+					} else {
+						auto tmp_folder = file_system.find_subfolder(current_folder, next_token);
+						if (tmp_folder != NONE) current_folder = tmp_folder; 
 					}
 				} else { // ls 
 					continue; 
 				}
 			} else if (next_token == "dir") {
-				line_stream >> next_token; 
-				std::unique_ptr<folder> new_folder = std::make_unique<folder>(std::move(next_token)); 
-				new_folder->set_parent(current_folder); 
-				current_folder->add_subfolder(new_folder);
+				file_system.add_subfolder(current_folder, aoc::next_field(line)); 
 			} else {
-				size_t file_size = std::stoul(next_token); 
-				line_stream >> next_token; // file name
-				current_folder->add_file(file_size, next_token); 
+				size_t file_size = aoc::to_int<size_t>(next_token); 
+				file_system.add_file(current_folder, file_size, aoc::next_field(line)); 
 			}
 		}
 
@@ -151,75 +171,44 @@ folder get_data(const std::string& file_name) {
 		std::cerr << "Could not open the file." << std::endl; 
 		exit(0); 
 	}
-
-	input_file.close(); 
-	return file_system; 
 } 
 
-size_t calculate_folder_size(const folder& folder, std::multimap<size_t, std::string>& folders_size) {
-	size_t size = 0; 
-
-	auto subfolders = folder.get_subfolders(); 
-	if (subfolders.size() > 0) {
-		for (const auto& s: subfolders) {
-			size += calculate_folder_size(*s, folders_size); 
-		}	
-	}
-
-	auto files = folder.get_files(); 
-	if (files.size() > 0) {
-		for (const auto& f: files) {
-			size += f.first; 
-		}
-	}
-
-	folders_size.insert({size, folder.name}); 
-	return size;
-}
-
-// Approach: store the folders sizes in a ordered multimap. After that, 
-// loop through the map until the folders reach size 100000. Sum up the 
-// sizes of such folders and report the result. 
-auto calculate_size_deletable_folders(const folder& file_system) {
-	size_t result; 
-	std::multimap<size_t, std::string> folders_size; 
-	calculate_folder_size(file_system, folders_size); 
-
+// Sum up the sizes of the folders of at most 100000 
+auto calculate_size_deletable_folders(const file_system_t& file_system) {
 	size_t folder_size = 0; 
-	auto folders_iterator = folders_size.begin(); 
-	while (folders_iterator != folders_size.end()) {
-		if (folders_iterator->first > 100000) break; 
-		folder_size += folders_iterator->first; 
-		folders_iterator++; 
+	for (const auto& f: file_system.folders) {
+		if (f.size <= 100000) folder_size += f.size; 
 	}
-
 	return folder_size; 
 }
 
-void solve_part_one(const folder& file_system) {
+void solve_part_one(const file_system_t& file_system) {
 	auto solution = calculate_size_deletable_folders(file_system); 
-	std::cout << "The solution to part one is " << solution << std::endl; 
+	aoc::out() << "The solution to part one is " << solution << std::endl; 
 } 
 
 // Find the smallest one among the candidate folders that can free up 
-// enough space on disk if removed. Once again, use the ordered 
-// multimap to store the folders sizes. 
-auto calculate_size_smallest_large_folder(const folder& file_system) {
-	size_t result{0}; 
-	std::multimap<size_t, std::string> folders_size; 
-	auto unused_space = 70000000 - calculate_folder_size(file_system, folders_size); 
-
-	for (const auto& f: folders_size) {
-		if (unused_space + f.first >= 30000000) {
-			result = f.first; 
-			break; 
-		}
+// enough space on disk if removed. 
+auto calculate_size_smallest_large_folder(const file_system_t& file_system) {
+	size_t result{NONE}; 
+	auto unused_space = 70000000 - file_system.folders[0].size; 
+
+	for (const auto& f: file_system.folders) {
+		if (unused_space + f.size >= 30000000 && f.size < result) result = f.size; 
 	}
 
-	return result; 
+	return result == NONE ? 0 : result; 
 }
 
-void solve_part_two(const folder& file_system) {
+void solve_part_two(const file_system_t& file_system) {
 	auto solution = calculate_size_smallest_large_folder(file_system); 
-	std::cout << "The solution to part two is " << solution << std::endl; 
-} 
\ No newline at end of file
+	aoc::out() << "The solution to part two is " << solution << std::endl; 
+}
+
+} // namespace day07
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day07::day, argc, argv); 
+}
+#endif
@@ -1,195 +1,234 @@
 #include <iostream> 
 #include <vector>
 #include <string> 
-#include <fstream>
+#include <cstdint> 
+#include <algorithm> 
+#include <stdexcept> 
 
-/* For this assignment, the tree grid will be stored as a matrix. 
-In particular, it will be seen like a vector of vectors, or, to say it better,
-as a vector of strings (we will consider strings as vectors of chars). */
+#include "day.h"
+#include "input.h"
+#include "thread_pool.h"
 
-void get_data(const std::string&, std::vector<std::string>&);
-void solve_part_one(const std::vector<std::string>&); 
-void solve_part_two(const std::vector<std::string>&); 
+namespace day08 {
 
-int main(int argc, char* argv[]) {
+/* For this assignment, the tree grid will be stored as a matrix: a single contiguous array of 
+heights (one byte per tree), row after row. 
+Part one: a tree is visible from a direction if it is taller than all the trees before it, so four 
+sweeps keeping the running maximum (left/right along the rows, up/down along the columns) mark all 
+the visible trees. 
+Part two: the viewing distance of every tree in a direction is found with a monotonic stack along the 
+row or column: the stack keeps the trees which can still block the view, and a tree pops all the 
+shorter ones, so that the top of the stack is the first tree at least as tall. Only the running maximum 
+of the scores is kept: the columns are carried down the grid with their stacks, a band of rows at a time. 
+Each sweep is O(1) amortized per tree, and the rows (columns) are processed in parallel blocks. */
+
+struct TreeGrid {
+    size_t n_rows = 0, n_cols = 0; 
+    std::vector<uint8_t> heights; 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 8 <<<" << std::endl; 
+    uint8_t at(size_t i, size_t j) const { return heights[i * n_cols + j]; }
+}; 
 
-    bool is_test = false; 
-    std::string file_name{};
-    std::vector<std::string> tree_grid; 
+constexpr size_t BLOCK_SIZE = 64;  // rows (or columns) handled by a parallel task 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
+void get_data(const std::string&, TreeGrid&);
+void solve_part_one(const TreeGrid&); 
+void solve_part_two(const TreeGrid&); 
 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+TreeGrid tree_grid; 
 
+void load(const std::string& file_name, bool) {
+    tree_grid = TreeGrid{}; 
     get_data(file_name, tree_grid); 
+}
 
-    if (is_test) {
-        std::cout << tree_grid.size()  << " by " << tree_grid.at(0).size() << " grid. Elements:" << std::endl;  
-        for (const auto& t: tree_grid) std::cout << t << std::endl; 
+void print() {
+    aoc::out() << tree_grid.n_rows  << " by " << tree_grid.n_cols << " grid. Elements:" << std::endl;  
+    for (size_t i = 0; i < tree_grid.n_rows; ++i) {
+        for (size_t j = 0; j < tree_grid.n_cols; ++j) aoc::out() << static_cast<char>('0' + tree_grid.at(i, j)); 
+        aoc::out() << std::endl; 
     }
+}
 
-    solve_part_one(tree_grid); 
-    solve_part_two(tree_grid); 
+void part_one() { solve_part_one(tree_grid); }
+void part_two() { solve_part_two(tree_grid); }
 
-}
+extern const aoc::Day day{8, load, print, part_one, part_two}; 
 
-void get_data(const std::string& file_name, std::vector<std::string>& tree_grid) {
-    std::ifstream input_file{file_name}; 
+void get_data(const std::string& file_name, TreeGrid& tree_grid) {
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string grid_line; 
-
-        while (std::getline(input_file, grid_line)) {
-            tree_grid.push_back(grid_line);     
+        for (auto grid_line: input_file.lines()) {
+            if (grid_line.empty()) continue; 
+            tree_grid.n_cols = grid_line.size(); 
+            for (auto c: grid_line) tree_grid.heights.push_back(static_cast<uint8_t>(c - '0')); 
+            ++tree_grid.n_rows; 
         }
 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-
-    input_file.close(); 
 }
 
-// The function takes the reference tree size as input, along with the position i-j of the tree grid
-// that such reference size must be compared with. If the current tree is larger, then 
-// keep looking to the direction given as input (up-down-left-right), and return if we reached the
-// edge of the grid. Otherwise, return false. 
-auto compare_trees(const std::vector<std::string>& tree_grid, const char& tree_size, size_t i, size_t j, const char direction) {
-
-    auto is_visible = tree_size > tree_grid.at(i).at(j); 
-    if (is_visible) {
-        // base case: if the tree is visible w.r.t the external trees, then it is a visible tree
-        if (i == 0 || j == 0 || i == tree_grid.size() - 1 || j == tree_grid.at(0).size() - 1) return true; 
-
-        switch (direction) {
-            case 'u': // keep looking up 
-                return is_visible && compare_trees(tree_grid, tree_size, i - 1, j, direction); 
-            case 'd': // keep looking down
-                return is_visible && compare_trees(tree_grid, tree_size, i + 1, j, direction);
-            case 'l': // keep looking left
-                return is_visible && compare_trees(tree_grid, tree_size, i, j - 1, direction);
-            case 'r': // keep looking right
-                return is_visible && compare_trees(tree_grid, tree_size, i, j + 1, direction);
-            default: 
-                return is_visible; 
-        }
-    }
-
-    // tree is not visible
-    return false; 
-
+// Runs task(first, last) on the blocks of [0, n) in parallel 
+template <typename Task> 
+void for_each_block(size_t n, Task&& task) {
+    aoc::parallel_for((n + BLOCK_SIZE - 1) / BLOCK_SIZE, [&](size_t b) {
+        task(b * BLOCK_SIZE, std::min(n, (b + 1) * BLOCK_SIZE)); 
+    }); 
 }
 
-// Approach: loops across all the trees internal to the grid (excluding the edge) 
-// and check whether they are visible from any of the directions. If that's the case, 
-// increase the count of visible trees by one as soon as one tree is considered visible. 
-// This could be optimized by taking into account the i-j position in the grid: if we are
-// close to a specific edge, we could reshuffle the order in which the search (that is, the
-// order of the calls to the compare_trees functions) is performed. 
-auto count_visible_trees(const std::vector<std::string>& tree_grid) {
-    auto n_rows = tree_grid.size(); 
-    auto n_cols = tree_grid.at(0).size(); 
-    auto n_visible_trees = n_rows * 2 + n_cols * 2 - 4; // the external trees are visible
-    for (size_t i = 1; i <= n_rows - 2; ++i) {
-        for (size_t j = 1; j <= n_cols - 2; ++j) {
-            const char tree_size = tree_grid.at(i).at(j); 
-            n_visible_trees += \
-                (compare_trees(tree_grid, tree_size, i - 1, j, 'u')) || // look up
-                (compare_trees(tree_grid, tree_size, i + 1, j, 'd')) || // or look down
-                (compare_trees(tree_grid, tree_size, i, j - 1, 'l')) || // or look left
-                (compare_trees(tree_grid, tree_size, i, j + 1, 'r'));   // or look right
+// Approach: prefix-maximum sweeps from the four edges. The rows are swept one by one, the columns a block 
+// at a time moving down (up) the rows, so that the memory is always accessed along the rows. 
+auto count_visible_trees(const TreeGrid& tree_grid) {
+    const auto n_rows = tree_grid.n_rows, n_cols = tree_grid.n_cols; 
+    std::vector<uint8_t> is_visible(n_rows * n_cols, 0); 
+
+    for_each_block(n_rows, [&](size_t first_row, size_t last_row) {
+        for (size_t i = first_row; i < last_row; ++i) {
+            int tallest = -1; 
+            for (size_t j = 0; j < n_cols; ++j) {
+                if (tree_grid.at(i, j) > tallest) { is_visible[i * n_cols + j] = 1; tallest = tree_grid.at(i, j); }
+            }
+            tallest = -1; 
+            for (size_t j = n_cols; j-- > 0;) {
+                if (tree_grid.at(i, j) > tallest) { is_visible[i * n_cols + j] = 1; tallest = tree_grid.at(i, j); }
+            }
         }
-    }
+    }); 
+
+    for_each_block(n_cols, [&](size_t first_col, size_t last_col) {
+        std::vector<int> tallest(last_col - first_col); 
+        std::fill(tallest.begin(), tallest.end(), -1); 
+        for (size_t i = 0; i < n_rows; ++i) {
+            for (size_t j = first_col; j < last_col; ++j) {
+                if (tree_grid.at(i, j) > tallest[j - first_col]) { is_visible[i * n_cols + j] = 1; tallest[j - first_col] = tree_grid.at(i, j); }
+            }
+        }
+        std::fill(tallest.begin(), tallest.end(), -1); 
+        for (size_t i = n_rows; i-- > 0;) {
+            for (size_t j = first_col; j < last_col; ++j) {
+                if (tree_grid.at(i, j) > tallest[j - first_col]) { is_visible[i * n_cols + j] = 1; tallest[j - first_col] = tree_grid.at(i, j); }
+            }
+        }
+    }); 
+
+    size_t n_visible_trees = 0; 
+    for (auto v: is_visible) n_visible_trees += v; 
     return n_visible_trees; 
 }
 
-/* Alternative idea: loop throught the rows and columns of the grid from all for directions. 
-These are the loops the we should implement: 
-    * row-wise from left 
-    * row-wise from right
-    * column-wise from up
-    * column-wise from down
-Across the loop, keep track of the largest tree. Whenever a new maximum is found, 
-add it to a std::unordered_set that keeps track of the visible trees. If the position i-j
-is already in the set, go to the next loop iteration. If the found tree has height 9, break the
-inner loop. 
-When the outer loop has ended, add the number of trees in the edges to the number of elements 
-inserted in the set, and return. 
-*/
-
-void solve_part_one(const std::vector<std::string>& tree_grid) {
+void solve_part_one(const TreeGrid& tree_grid) {
     auto solution = count_visible_trees(tree_grid); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 // For part 2: 
-// The function calculates the scenic score of a specific tree, by calculating the 
-// corresponding scores in each directions and mulitplying such scores with each other. 
-// It takes as input the corresponding positions i_ref-j_ref of the tree under examination.
-auto calculate_tree_scenic_score(const std::vector<std::string>& tree_grid, const size_t i_ref, const size_t j_ref) {
-    const char tree_size = tree_grid.at(i_ref).at(j_ref); 
-    size_t scenic_score = 1; 
-
-    // Score up
-    size_t tmp_score = 1; // note that this already includes either the "edge score" or the "high next tree" score
-    int i = i_ref - 1; 
-    while ( i > 0 && tree_grid.at(i).at(j_ref) < tree_size) {
-        tmp_score += 1; 
-        --i; 
+// Monotonic stack of the positions of the trees which may still block the view along a line. Given the 
+// next tree (at position k along the line), it returns its viewing distance back along the line: up to 
+// the first tree at least as tall, or up to the edge. 
+struct ViewStack {
+    std::vector<std::pair<uint8_t, size_t>> trees;  // (height, position) 
+
+    size_t viewing_distance(uint8_t height, size_t k) {
+        while (!trees.empty() && trees.back().first < height) trees.pop_back(); 
+        auto distance = trees.empty() ? k : k - trees.back().second; 
+        trees.emplace_back(height, k); 
+        return distance; 
     }
-    scenic_score *= tmp_score; 
-
-    // Score down
-    tmp_score = 1; 
-    i = i_ref  + 1;
-    while ( i < tree_grid.size() - 1 && tree_grid.at(i).at(j_ref) < tree_size) {
-        tmp_score += 1; 
-        ++i; 
+}; 
+
+// Column stack for the vertical views. It keeps the trees above the current row which can still block 
+// a view, strictly decreasing in height, each one with its partial score (left * right * up): the next 
+// tree at least as tall closes the view down of the trees it pops, which completes their scores. 
+struct ColumnStack {
+    struct Tree { uint8_t height; uint32_t row; uint64_t partial_score; }; 
+    std::vector<Tree> trees; 
+
+    // Pushes the tree at row i, returning the best score completed by it 
+    uint64_t push(uint8_t height, uint32_t i, uint64_t horizontal_score) {
+        uint64_t best = 0; 
+        uint32_t blocker = i; // The tree's view up ends at the edge (distance i) unless something blocks it 
+        bool is_blocked = false; 
+        while (!trees.empty() && trees.back().height <= height) {
+            const auto& tree = trees.back(); 
+            best = std::max(best, tree.partial_score * (i - tree.row)); 
+            if (tree.height == height) { blocker = tree.row; is_blocked = true; }
+            trees.pop_back(); 
+        }
+        if (!is_blocked && !trees.empty()) { blocker = trees.back().row; is_blocked = true; }
+        trees.push_back({height, i, horizontal_score * (is_blocked ? i - blocker : i)}); 
+        return best; 
     }
-    scenic_score *= tmp_score; 
-
-    // Score left
-    tmp_score = 1; 
-    int j = j_ref - 1;
-    while ( j > 0 && tree_grid.at(i_ref).at(j) < tree_size) {
-        tmp_score += 1; 
-        --j; 
+
+    // Closes the views down of the trees left at the bottom edge (last row n_rows - 1) 
+    uint64_t finish(uint32_t last_row) {
+        uint64_t best = 0; 
+        for (const auto& tree: trees) best = std::max(best, tree.partial_score * (last_row - tree.row)); 
+        trees.clear(); 
+        return best; 
     }
-    scenic_score *= tmp_score; 
-
-    // Score right
-    tmp_score = 1; 
-    j = j_ref + 1;
-    while ( j < tree_grid.at(0).size() - 1 && tree_grid.at(i_ref).at(j) < tree_size) {
-        tmp_score += 1; 
-        ++j; 
+}; 
+
+// Approach: the grid is swept down a band of BLOCK_SIZE rows at a time. The viewing distances along the rows 
+// of the band are found with a monotonic stack, and their products kept for the band only. Then each column 
+// is carried down through the band by its ColumnStack, which completes the score of a tree once its view down 
+// is blocked. Only the running maximum of the scores is kept, so the memory does not grow with the grid. 
+auto find_best_scenic_score(const TreeGrid& tree_grid) {
+    const auto n_rows = tree_grid.n_rows, n_cols = tree_grid.n_cols; 
+    if (n_rows == 0 || n_cols == 0) return uint64_t{0}; 
+    if (n_rows > UINT32_MAX) throw std::runtime_error("too many rows for the scenic scores"); 
+
+    // left * right is at most (n_cols / 2)^2, which fits 32 bits for any line up to 2^17 trees 
+    using HorizontalScore = uint32_t; 
+    if (n_cols >= (size_t{1} << 17)) throw std::runtime_error("too many columns for the scenic scores"); 
+
+    std::vector<HorizontalScore> band_scores(BLOCK_SIZE * n_cols); 
+    std::vector<ColumnStack> column_stacks(n_cols); 
+    std::vector<uint64_t> best_scores((n_cols + BLOCK_SIZE - 1) / BLOCK_SIZE, 0);  // One per column block 
+
+    for (size_t first_row = 0; first_row < n_rows; first_row += BLOCK_SIZE) {
+        const auto last_row = std::min(n_rows, first_row + BLOCK_SIZE); 
+
+        aoc::parallel_for(last_row - first_row, [&](size_t r) {
+            const auto i = first_row + r; 
+            auto* scores = band_scores.data() + r * n_cols; 
+            ViewStack stack; 
+            for (size_t j = 0; j < n_cols; ++j) scores[j] = stack.viewing_distance(tree_grid.at(i, j), j); 
+            stack.trees.clear(); 
+            for (size_t j = n_cols; j-- > 0;) scores[j] *= stack.viewing_distance(tree_grid.at(i, j), n_cols - 1 - j); 
+        }); 
+
+        for_each_block(n_cols, [&](size_t first_col, size_t last_col) {
+            auto& best = best_scores[first_col / BLOCK_SIZE]; 
+            for (size_t i = first_row; i < last_row; ++i) {
+                const auto* scores = band_scores.data() + (i - first_row) * n_cols; 
+                for (size_t j = first_col; j < last_col; ++j) {
+                    best = std::max(best, column_stacks[j].push(tree_grid.at(i, j), static_cast<uint32_t>(i), scores[j])); 
+                }
+            }
+        }); 
     }
-    scenic_score *= tmp_score; 
-
-    return scenic_score;
-}
 
-// Approach: loops through every tree in the grid, and calculate the scenic score
-// for each tree. Return the maximum scenic score. 
-auto find_best_scenic_score(const std::vector<std::string>& tree_grid) {
-    size_t scenic_score = 0; 
-    size_t tmp_score; 
+    for_each_block(n_cols, [&](size_t first_col, size_t last_col) {
+        auto& best = best_scores[first_col / BLOCK_SIZE]; 
+        for (size_t j = first_col; j < last_col; ++j) best = std::max(best, column_stacks[j].finish(static_cast<uint32_t>(n_rows - 1))); 
+    }); 
 
-    for (size_t i = 1; i < tree_grid.size() - 1; ++i) {
-        for (size_t j = 1; j < tree_grid.at(0).size() - 1; ++j) {
-            if ((tmp_score = calculate_tree_scenic_score(tree_grid, i, j)) > scenic_score) {
-                scenic_score = tmp_score;
-            }
-        }
-    }
-    return scenic_score; 
+    return *std::max_element(best_scores.begin(), best_scores.end()); 
 }
 
-void solve_part_two(const std::vector<std::string>& tree_grid) {
+void solve_part_two(const TreeGrid& tree_grid) {
     auto solution = find_best_scenic_score(tree_grid); 
-    std::cout << "The solution to part two is " << solution << std::endl; 
-}
\ No newline at end of file
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
+}
+
+} // namespace day08
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day08::day, argc, argv); 
+}
+#endif
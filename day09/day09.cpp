@@ -1,54 +1,61 @@
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <iostream>
-#include <unordered_set> 
 #include <vector> 
 #include <utility> 
+#include <algorithm> 
+#include <cstdint> 
+#include <cstdlib> 
 
-using steps = std::pair<char, int>; 
-
-void get_data(const std::string&, std::vector<steps>&); 
-void solve_part_one(const std::vector<steps>&); 
-void solve_part_two(const std::vector<steps>&); 
+#include "day.h"
+#include "input.h"
 
-int main(int argc, char* argv[]) {
+namespace day09 {
 
-    std::cout << ">>> Advent Of Code 2022 - Day 9 <<<" << std::endl; 
+using steps = std::pair<char, int>; 
 
-    std::string file_name; 
-    bool is_test; 
-    std::vector<steps> instructions; 
+void get_data(const std::string&, std::vector<steps>&); 
+void solve_part_one(); 
+void solve_part_two(); 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::vector<steps> instructions; 
+size_t n_knots = 10; 
+bool print_all_knots = false; 
 
+void load(const std::string& file_name, bool) {
+    instructions.clear(); 
     get_data(file_name, instructions); 
+}
 
-    if (is_test) {
-        for (const auto& i: instructions) {
-            std::cout << i.first << " - " << i.second << std::endl; 
-        }
+void print() {
+    for (const auto& i: instructions) {
+        aoc::out() << i.first << " - " << i.second << std::endl; 
     }
+}
 
-    solve_part_one(instructions); 
-    solve_part_two(instructions); 
+void part_one() { solve_part_one(); }
+void part_two() { solve_part_two(); }
 
-    return 0; 
+// "--knots N" also prints the positions visited by every knot of a rope of N knots 
+void set_knots(std::string_view n) {
+    n_knots = std::max<size_t>(aoc::to_int<size_t>(n), 1); 
+    print_all_knots = true; 
 }
 
+extern const aoc::Day day{9, load, print, part_one, part_two, {
+    {"--knots", true, set_knots}
+}}; 
+
 void get_data(const std::string& file_name, std::vector<steps>& instructions) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            std::istringstream line_stream{line}; 
-            char direction; 
-            int n_steps; 
-            line_stream >> direction; 
-            line_stream >> n_steps; 
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            // Each line is "<direction> <steps>" 
+            char direction = line[0]; 
+            line.remove_prefix(1); 
+            int n_steps{0}; 
+            aoc::next_int(line, n_steps); 
             instructions.emplace_back(direction, n_steps); 
         }
     } else {
@@ -56,148 +63,112 @@ void get_data(const std::string& file_name, std::vector<steps>& instructions) {
         exit(0); 
     }
 
-    input_file.close(); 
-
 } 
 
-// This function checks where the tail and head are positioned, and moves the tail 
-// accordingly. These are the positions to check: 
-// if i_tail == i_head, it checks how far the head is horizontally 
-// if j_tail == j_head, it checks how far the head is vertically 
-// else it needs to make sure the diagonal distance is within one step max in either direction 
-// The function returns true if the tail knot has moved
-// For part two, the tail is the knot under examination, while the head is the knot preceding 
-// the one under examination. 
-auto check_and_move_tail(int& i_tail, int& j_tail,  const int i_head, const int j_head) -> bool {
-
-    // Horizontal alignment
-    if (i_head == i_tail) {
-        if (j_head - j_tail > 1) {
-            j_tail++; // We only neew to move one step as the function is called at every head's step
-        } else if (j_head - j_tail < -1) {
-            j_tail--; 
-        }
-        return true; 
-    }
+// The positions are packed in 64-bit keys (x in the high half, y in the low half, both offset so that 
+// the key of a real position is never 0, which marks the empty slots of the set) 
+using position_key = uint64_t; 
 
-    // Vertical alignment 
-    if (j_head == j_tail) {
-        if (i_head - i_tail > 1) {
-            i_tail++;
-        } else if (i_head - i_tail < -1) {
-            i_tail--; 
+position_key to_key(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x) ^ 0x80000000u) << 32) | (static_cast<uint32_t>(y) ^ 0x80000000u); 
+}
+
+// Set of visited positions: open addressing with linear probing over a power-of-two table, which is 
+// doubled whenever it gets more than half full 
+class PositionSet {
+  public: 
+    PositionSet() : slots(64, 0) {} 
+
+    void insert(position_key key) {
+        auto i = slot_of(key); 
+        while (slots[i] != 0) {
+            if (slots[i] == key) return; 
+            i = (i + 1) & (slots.size() - 1); 
         }
-        return true; 
+        slots[i] = key; 
+        if (++n_keys * 2 > slots.size()) grow(); 
     }
 
-    if (std::abs(i_head - i_tail) > 1 || // The head is more than one step above/below the tail
-        std::abs(j_head - j_tail) > 1) { // The head is more than one step left/right of the tail
-        i_tail = (i_head > i_tail) ? i_tail+1 : i_tail-1; // We only neew to move one step as the 
-        j_tail = (j_head > j_tail) ? j_tail+1 : j_tail-1; // function is called at every head's step
-        return true; 
-    } 
+    size_t size() const { return n_keys; } 
 
-    return false; 
+  private: 
+    std::vector<position_key> slots; 
+    size_t n_keys = 0; 
+
+    size_t slot_of(position_key key) const {
+        // Fibonacci hashing: the high bits of the product are well mixed 
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1); 
+    }
 
+    void grow() {
+        std::vector<position_key> old_slots(slots.size() * 2, 0); 
+        old_slots.swap(slots); 
+        n_keys = 0; 
+        for (auto key: old_slots) if (key != 0) insert(key); 
+    }
+}; 
+
+struct Knot {
+    int x = 0, y = 0; 
+}; 
+
+// Moves the knot one step towards the preceding one if they are no longer touching (i.e. if they are 
+// more than one step apart in either direction). The step is diagonal unless the knots are aligned. 
+// Returns true if the knot has moved 
+bool follow(Knot& knot, const Knot& preceding) {
+    int dx = preceding.x - knot.x, dy = preceding.y - knot.y; 
+    if (std::abs(dx) <= 1 && std::abs(dy) <= 1) return false; 
+    knot.x += (dx > 0) - (dx < 0); 
+    knot.y += (dy > 0) - (dy < 0); 
+    return true; 
 }
 
-// Approach: loop through the instructions with the head (starting from 0,0) and 
-// have the tail move accordingly with the check_and_move tail function defined above.
-// Insert in a std::unordered_set (a hash map) the steps by the tail, 
-// and finally return the size of such set 
-auto count_visited_positions(const std::vector<steps>& instructions) {
-    std::unordered_set<std::string> visited_positions; 
-    int i_head{0}, i_tail{0}, j_head{0}, j_tail{0}; // set starting positions
-    // For simplicity we assume the starting point is (0,0) -> the grid can take negative values, 
-    // potentially, but this is not relevant for the solution of the problem 
+// Approach: simulate a rope of n_knots knots (all starting at 0,0) in a single pass through the instructions, 
+// keeping a set of the visited positions for every knot. At each step of the head, the following knots are 
+// updated in order; as soon as a knot does not move, none of the following ones can move either, so the 
+// update stops there. Returns the number of positions visited by each knot (the head is knot 0). 
+std::vector<size_t> count_visited_positions(const std::vector<steps>& instructions, size_t n_knots) {
+    std::vector<Knot> rope(n_knots); 
+    std::vector<PositionSet> visited_positions(n_knots); 
+    for (auto& v: visited_positions) v.insert(to_key(0, 0)); 
 
     for (const auto& i: instructions) {
-        auto direction = i.first;
-        auto n_steps = i.second; 
-
-        while (n_steps > 0) {
-            switch (direction) {
-                case 'U': 
-                    i_head++; 
-                    break; 
-                case 'D': 
-                    i_head--; 
-                    break; 
-                case 'R':
-                    j_head++; 
-                    break; 
-                case 'L':
-                    j_head--;
-                    break;
-                default:
-                    break; 
+        int dx = (i.first == 'R') - (i.first == 'L'); 
+        int dy = (i.first == 'U') - (i.first == 'D'); 
+
+        for (int n_steps = i.second; n_steps > 0; --n_steps) {
+            rope[0].x += dx; 
+            rope[0].y += dy; 
+            visited_positions[0].insert(to_key(rope[0].x, rope[0].y)); 
+            for (size_t k = 1; k < n_knots && follow(rope[k], rope[k - 1]); ++k) {
+                visited_positions[k].insert(to_key(rope[k].x, rope[k].y)); 
             }
-            if (check_and_move_tail(i_tail, j_tail,  i_head, j_head)) {
-                // Note that .insert() only inserts if the key is not already in the set 
-                visited_positions.insert(std::to_string(i_tail) + "-" + std::to_string(j_tail));
-            } 
-            n_steps--;
-        } 
+        }
     }
-    return visited_positions.size(); 
-}
 
-// Function for part 2. The logic is the same as with part 1, but we are using 
-// a vector of knots instead of just the head-tail knots. 
-auto count_visited_positions_large_rope(const std::vector<steps>& instructions) {
-    std::unordered_set<std::string> visited_positions;  
-    // Create a rope of ten knots all at the starting point (0,0)
-    std::vector<std::pair<int, int>> rope(10, std::make_pair(0,0)); 
+    std::vector<size_t> n_visited(n_knots); 
+    for (size_t k = 0; k < n_knots; ++k) n_visited[k] = visited_positions[k].size(); 
+    return n_visited; 
+}
 
-    for (const auto& i: instructions) {
-        auto direction = i.first;
-        auto n_steps = i.second; 
-
-        while (n_steps > 0) {
-            // Start with the head knot:
-            switch (direction) {
-                case 'U': 
-                    rope.at(0).first++; 
-                    break; 
-                case 'D': 
-                    rope.at(0).first--; 
-                    break; 
-                case 'R':
-                    rope.at(0).second++; 
-                    break; 
-                case 'L':
-                    rope.at(0).second--;
-                    break;
-                default:
-                    break; 
-            }
-            // Now loop through the other rope's knots and update the knots positions
-            // This is optimized by breaking the loop when a knot stops moving 
-            // (we don't need to check the next knots)
-            for (size_t k = 1; k < rope.size(); ++k) {
-                if(!check_and_move_tail(rope.at(k).first, rope.at(k).second,  
-                    rope.at(k-1).first, rope.at(k-1).second)) {
-                        break; 
-                    }
-
-                if (k == rope.size() - 1) {
-                    // Note that .insert() only inserts if the key is not already in the set 
-                    visited_positions.insert(std::to_string(rope.at(9).first) + "-" + std::to_string(rope.at(9).second)); 
-                }
-            }
-            
-            n_steps--;
-        } 
+// Part one only needs a rope of two knots; part two simulates a rope of (at least) ten knots, which also 
+// gives the positions visited by every knot of a longer rope 
+void solve_part_one() {
+    auto solution = count_visited_positions(instructions, 2)[1]; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
+}
+void solve_part_two() {
+    auto n_visited = count_visited_positions(instructions, std::max<size_t>(n_knots, 10)); 
+    aoc::out() << "The solution to part two is " << n_visited[9] << std::endl; 
+    if (print_all_knots) {
+        for (size_t k = 0; k < n_knots; ++k) aoc::out() << "Knot " << k << " visited " << n_visited[k] << " positions" << std::endl; 
     }
-    return visited_positions.size(); 
 }
 
+} // namespace day09
 
-void solve_part_one(const std::vector<steps>& instructions) {
-    auto solution = count_visited_positions(instructions); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day09::day, argc, argv); 
 }
-void solve_part_two(const std::vector<steps>& instructions) {
-    auto solution = count_visited_positions_large_rope(instructions); 
-    std::cout << "The solution to part two is " << solution << std::endl; 
-}
\ No newline at end of file
+#endif
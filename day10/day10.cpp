@@ -1,163 +1,162 @@
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <iostream>
 #include <vector> 
 #include <utility> 
+#include <algorithm> 
+#include <cstdint> 
+#include <string_view> 
 
-void get_data(const std::string&, std::vector<std::string>&); 
-void solve_part_one(const std::vector<std::string>&); 
-void solve_part_two(const std::vector<std::string>&); 
+#include "day.h"
+#include "input.h"
 
-int main(int argc, char* argv[]) {
+namespace day10 {
 
-    std::cout << ">>> Advent Of Code 2022 - Day 10 <<<" << std::endl; 
+// The program is decoded once into a compact array of instructions, which is then executed by a single 
+// emulator core. The core calls an observer at every cycle (with the value of the X register during that 
+// cycle), so each part is an observer of its own run: one samples the signal strength at the given cycles, 
+// the other draws the pixels of the CRT. 
 
-    std::string file_name; 
-    bool is_test; 
-    std::vector<std::string> instructions; 
+enum class Opcode : uint8_t { noop, addx }; 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+struct Instruction {
+    Opcode opcode; 
+    int operand;  // only used by addx 
+}; 
 
-    get_data(file_name, instructions); 
+void get_data(const std::string&, std::vector<Instruction>&); 
+void solve_part_one(); 
+void solve_part_two(); 
 
-    if (is_test) {
-        for (const auto& i: instructions) {
-            std::cout << i << std::endl; 
-        }
+std::vector<Instruction> program; 
+
+// The cycles at which the signal strength is sampled, and the size of the screen 
+std::vector<long> sample_cycles{20, 60, 100, 140, 180, 220}; 
+size_t screen_width = 40, screen_height = 6; 
+
+void load(const std::string& file_name, bool) {
+    program.clear(); 
+    get_data(file_name, program); 
+}
+
+void print() {
+    for (const auto& i: program) {
+        if (i.opcode == Opcode::addx) aoc::out() << "addx " << i.operand << std::endl; 
+        else aoc::out() << "noop" << std::endl; 
     }
+}
 
-    solve_part_one(instructions); 
-    solve_part_two(instructions); 
+void part_one() { solve_part_one(); }
+void part_two() { solve_part_two(); }
+
+// "--samples C1,C2,..." sets the cycles at which the signal strength is sampled, and "--screen WxH" the size 
+// of the CRT 
+void set_samples(std::string_view cycles) {
+    sample_cycles.clear(); 
+    while (!cycles.empty()) {
+        // The first cycle is 1: an earlier one could never be reached, and would hold back the later samples 
+        auto cycle = aoc::to_int<long>(aoc::next_field(cycles, ',')); 
+        if (cycle >= 1) sample_cycles.push_back(cycle); 
+    }
+    std::sort(sample_cycles.begin(), sample_cycles.end()); 
+    sample_cycles.erase(std::unique(sample_cycles.begin(), sample_cycles.end()), sample_cycles.end()); 
+}
 
-    return 0; 
+void set_screen(std::string_view size) {
+    screen_width = std::max<size_t>(aoc::to_int<size_t>(aoc::next_field(size, 'x')), 1); 
+    screen_height = aoc::to_int<size_t>(size); 
 }
 
-void get_data(const std::string& file_name, std::vector<std::string>& instructions) {
-    std::ifstream input_file{file_name}; 
+extern const aoc::Day day{10, load, print, part_one, part_two, {
+    {"--samples", true, set_samples}, 
+    {"--screen", true, set_screen}
+}}; 
+
+void get_data(const std::string& file_name, std::vector<Instruction>& program) {
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            instructions.push_back(line); 
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            // Each line is either "noop" or "addx <value>" 
+            if (aoc::skip_prefix(line, "addx ")) {
+                int value{0}; 
+                aoc::next_int(line, value); 
+                program.push_back({Opcode::addx, value}); 
+            } else {
+                program.push_back({Opcode::noop, 0}); 
+            }
         }
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
 
-    input_file.close(); 
-
 } 
 
-// Approach: loop through each instructio, increase the cycle number according to 
-// the instruction type. After each increase, check if we are at one of the cycles
-// we need to record. If that's the case, get the update register value and muliply it 
-// with the corresponding cycle number.
-auto calculate_signal_strength(const std::vector<std::string>& instructions) {
-
-    size_t cycle = 0; 
+// The emulator core: noop takes one cycle, addx takes two and updates the X register at the end of the 
+// second one. observe(cycle, x) is called during every cycle (the cycles are numbered from 1); the run 
+// stops as soon as the observer returns false, so a very long program is only executed as far as needed 
+template <typename Observer> 
+void run_program(const std::vector<Instruction>& program, Observer&& observe) {
+    long cycle = 0; 
     int x_register_value = 1; 
-    int signal_strength = 0; 
-    size_t next_cycle_to_examine = 20; 
-
-    for (const auto& i: instructions) {
-        cycle += 1; // either noop or addx add the cycle 
-
-        if (cycle == next_cycle_to_examine) {
-            signal_strength += cycle * x_register_value; 
-            if ((next_cycle_to_examine += 40) > 220) break; 
-        }
-
-        if (i.find("addx") == 0) {
-            cycle += 1;     // the second cycle for addx 
 
-            // Recheck if we are in one of the cycles under examination
-            // We're still in the beginning of the cycle so the check must be performed before
-            // the register is updated
-            if (cycle == next_cycle_to_examine) {
-                signal_strength += cycle * x_register_value; 
-                if ((next_cycle_to_examine += 40) > 220) break; 
-            }
-
-            std::string tmp; 
-            int register_value_to_add{0}; 
-            std::istringstream addx_stream{i}; 
-            addx_stream >> tmp; // the "addx" instruction per se  
-            addx_stream >> register_value_to_add; 
-            x_register_value += register_value_to_add; 
+    for (const auto& i: program) {
+        if (!observe(++cycle, x_register_value)) return; 
+        if (i.opcode == Opcode::addx) {
+            if (!observe(++cycle, x_register_value)) return; 
+            x_register_value += i.operand; 
         }
     }
+}
 
+// Part one: the signal strength is the sum of cycle * X over the sampled cycles (a sorted list). The run 
+// stops after the last sampled cycle 
+long long measure_signal_strength(const std::vector<Instruction>& program) {
+    long long signal_strength = 0; 
+    size_t next_sample = 0; 
+    run_program(program, [&](long cycle, int x) {
+        if (next_sample < sample_cycles.size() && cycle == sample_cycles[next_sample]) {
+            signal_strength += cycle * x; 
+            ++next_sample; 
+        }
+        return next_sample < sample_cycles.size(); 
+    }); 
     return signal_strength; 
-
 }
 
-void solve_part_one(const std::vector<std::string>& instructions) {
-    auto solution = calculate_signal_strength(instructions); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+// Part two: the CRT draws one pixel per cycle, moving left to right and then down the rows, and the pixel is 
+// lit if the sprite (X-1, X, X+1) covers its column. The run stops when the screen is full 
+std::vector<std::string> draw_image(const std::vector<Instruction>& program) {
+    std::vector<std::string> image(screen_height, ""); 
+    const long n_pixels = static_cast<long>(screen_width * screen_height); 
+    const long width = static_cast<long>(screen_width); 
+    run_program(program, [&](long cycle, int x) {
+        if (cycle > n_pixels) return false; 
+        long column = (cycle - 1) % width; 
+        image[(cycle - 1) / width].push_back(column >= x - 1 && column <= x + 1 ? '#' : '.'); 
+        return cycle < n_pixels; 
+    }); 
+    return image; 
 }
 
-// For part two - Approach: loop across the instruction, and update the 
-// column position at each instruction (reset to 0 when we reach the 40th column). 
-// If the instruction is addx, the column position is updated twice. If the considered 
-// column is in the sprie (included in [x-1, x+1]) then print "#", otherwise print "*"
-auto draw_image(const std::vector<std::string>& instructions) {
-
-    const int ROW_WIDTH = 40; 
-    const int COLUMN_HEIGHT = 6; 
-    int current_row = 0; 
-    int current_column = 0; // the column can be see as a cycle counter, together with the row 
-    int x_register_value = 1; 
-    std::vector<std::string> image(COLUMN_HEIGHT, ""); 
-
-    for (const auto& i: instructions) {
-        if (current_row > COLUMN_HEIGHT) break; 
-
-        if (current_column >= x_register_value - 1 && current_column <= x_register_value + 1) {
-            image.at(current_row).push_back('#');
-        } else {
-            image.at(current_row).push_back('.');
-        }
-
-        current_column++;
-        if (current_column == ROW_WIDTH) {
-            current_column = 0; 
-            current_row++; 
-        }
-
-        if (i.find("addx") == 0) {
-            if (current_column >= x_register_value - 1 && current_column <= x_register_value + 1) {
-                image.at(current_row).push_back('#');
-            } else {
-                image.at(current_row).push_back('.');
-            }
-
-            current_column++;
-            if (current_column == ROW_WIDTH) {
-                current_column = 0; 
-                current_row++; 
-            }
-            
-            // Update the x register value
-            std::string tmp; 
-            int x_register_value_change{0}; 
-            std::istringstream instruction_stream(i); 
-            instruction_stream >> tmp; // "addx" instruction 
-            instruction_stream >> x_register_value_change; 
-            x_register_value += x_register_value_change; 
-        }
-    }
-    return image;
-} 
+void solve_part_one() {
+    auto solution = measure_signal_strength(program); 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
+}
 
-void solve_part_two(const std::vector<std::string>& instructions) {
-    auto solution = draw_image(instructions); 
-    std::cout << "The solution to part two is: " << std::endl; 
+void solve_part_two() {
+    auto solution = draw_image(program); 
+    aoc::out() << "The solution to part two is: " << std::endl; 
     for (const auto& s: solution) {
-        std::cout << s << std::endl; 
+        aoc::out() << s << std::endl; 
     }
 }
 
+} // namespace day10
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day10::day, argc, argv); 
+}
+#endif
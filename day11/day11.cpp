@@ -1,217 +1,128 @@
-#include <functional>
-#include <queue>
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <utility> 
-
-// The following are the two types of functions that can increase the "item worry level"
-// That is, an additive and a multiplicative one 
-auto multiplicative_worry_function = [](long int old, long int par) {
-    return old * par; 
-};
-
-auto additive_worry_function = [](long int old, long int par) {
-    return old + par; 
+#include <algorithm> 
+#include <functional> 
+#include <cstdint> 
+#include <atomic> 
+#include <stdexcept> 
+
+#include "day.h"
+#include "input.h"
+#include "thread_pool.h"
+
+namespace day11 {
+
+// The monkeys are stored as a structure of arrays (one entry per monkey in each array), and their 
+// operations are compiled into a tagged enum, so that the simulation is a tight loop without any 
+// indirect call. 
+// The items never interact: where an item goes only depends on its own worry level, and the monkeys 
+// inspect the items in a fixed order within a round. So each item is simulated on its own, through 
+// all the rounds, counting the inspections of every monkey along its route; the counts of all the 
+// items are then summed. The items are simulated in parallel. 
+// In part two the worry levels are kept modulo the product of the divisors of the tests, so the 
+// state of an item at the beginning of a round, (monkey, worry level), can only take finitely many 
+// values: sooner or later the item enters a cycle, and the rounds after that are not simulated but 
+// counted by whole cycles. 
+
+enum class Operation : uint8_t { add, multiply, square }; 
+
+struct Monkeys {
+    std::vector<Operation> operations; 
+    std::vector<uint64_t> operands;  // the second term of add and multiply 
+    std::vector<uint64_t> test_values; 
+    std::vector<uint8_t> monkeys_if_true; 
+    std::vector<uint8_t> monkeys_if_false; 
+
+    size_t size() const { return operations.size(); } 
 }; 
 
-// This class represents all the monkeys characteristics: 
-// * it holds some items, represented by the "worry level", which we containerize in a queue
-// * is has a function that calculates the worry level for a specific item 
-// * it has a test value that allows deciding to which monkey the item is thrown
-// * it has a monkey to which the item is thrown in case of a positive test, and another one for negative tests 
-class Monkey {
-
-    private: 
-    std::queue<long int> items_;
-    std::function<long int(long int, long int)> update_worry_level_;   
-    const int number_; 
-    const long int test_value_; 
-    const int monkey_positive_number_; 
-    const int monkey_negative_number_; 
-    long int worry_parameter_; 
-
-    public: 
-    Monkey(int monkey_number, long int test_value, std::queue<long int> items, 
-            int monkey_positive, int monkey_negative) noexcept : 
-        number_(monkey_number), test_value_(test_value), items_(std::move(items)), 
-            monkey_positive_number_(monkey_positive), monkey_negative_number_(monkey_negative) {
-        update_worry_level_ = additive_worry_function; // default: additive function
-        worry_parameter_ = -1; // worry_parameter is < 0 if the second parameter is a worry level
-    }
-
-    auto get_monkey_number() const noexcept {
-        return number_; 
-    }
-
-    auto get_test_value() const noexcept {
-        return test_value_; 
-    }
-
-    void set_worry_function(std::function<long int(long int, long int)> worry_function) noexcept {
-        this->update_worry_level_ = worry_function; 
-    }
+struct Item {
+    uint8_t monkey;  // the monkey holding the item 
+    uint64_t worry_level; 
 
-    void set_worry_function_parameter(long int parameter) noexcept {
-        this->worry_parameter_ = parameter;
-    }
+    bool operator==(const Item& other) const { return monkey == other.monkey && worry_level == other.worry_level; }
+    bool operator!=(const Item& other) const { return !(*this == other); }
+}; 
 
-    auto& get_items() noexcept {
-        return this->items_;
-    }
+void get_data(const std::string&, Monkeys&, std::vector<Item>&); 
+void solve_part_one(); 
+void solve_part_two(); 
 
-    // Performs a round for a monkey 
-    auto inspect_and_throw_items(long int worry_relief, std::vector<Monkey>& monkeys, bool divideByWorryRelief) -> long int {
-        if (items_.size() == 0) {
-            return 0; 
-        }
+Monkeys monkeys; 
+std::vector<Item> items;  // the starting items, in the order of the input 
+size_t n_rounds_part_two = 10000; 
 
-        auto& monkey_positive_ = monkeys.at(monkey_positive_number_); 
-        auto& monkey_negative_ = monkeys.at(monkey_negative_number_); 
-
-        auto n_items = items_.size(); 
-        while (!items_.empty()) {
-            auto item_ = items_.front(); 
-            long int updated_item; 
-            if (this->worry_parameter_ < 0) {
-                updated_item = update_worry_level_(item_, item_); 
-            } else {
-                updated_item = update_worry_level_(item_, this->worry_parameter_); 
-            }
-            
-            // Perform the test and throw the updated item to the corresponding monkey
-            // Here, we' re in part one of the assignment
-            if (divideByWorryRelief) updated_item /= worry_relief;
-            auto test = updated_item % test_value_ == 0;
-            // In part two of the assignment, we need to keep the relief manageable
-            // So I mod the worry level with the least common multiple of 
-            // all the divisor test values (also passed as worry relief here)
-            if (!divideByWorryRelief) updated_item %= worry_relief;  
-            if (test) {
-                monkey_positive_.get_items().push(updated_item); 
-            } else {    
-                monkey_negative_.get_items().push(updated_item); 
-            }
-            items_.pop(); 
-        }
-        return n_items; 
-    }
+void load(const std::string& file_name, bool) {
+    monkeys = Monkeys{}; 
+    items.clear(); 
+    get_data(file_name, monkeys, items); 
+}
 
-    void to_string() const {
-        // Quite expensive function as we are copying the std::queue 
-        // Used only for testing purposes 
-        std::queue<long int> items_copy = this->items_; 
-        std::cout << "Monkey " << number_ << ":" << std::endl; 
-        std::cout << "  " << "Starting items: "; 
-        while (!items_copy.empty()) {
-            std::cout << items_copy.front() << " "; 
-            items_copy.pop(); 
+void print() {
+    for (size_t m = 0; m < monkeys.size(); ++m) {
+        aoc::out() << "Monkey " << m << ":" << std::endl; 
+        aoc::out() << "  " << "Starting items: "; 
+        for (const auto& i: items) {
+            if (i.monkey == m) aoc::out() << i.worry_level << " "; 
         }
-        std::cout << std::endl; 
-        std::cout << "Parameter: " << worry_parameter_ << std::endl; 
-        std::cout << "Monkey if true: " << monkey_positive_number_ << std::endl;
-        std::cout << "Monkey if false: " << monkey_negative_number_ << std::endl;
+        aoc::out() << std::endl; 
+        // The parameter of "old * old" is printed as -1 
+        long int parameter = monkeys.operations[m] == Operation::square ? -1 : static_cast<long int>(monkeys.operands[m]); 
+        aoc::out() << "Parameter: " << parameter << std::endl; 
+        aoc::out() << "Monkey if true: " << static_cast<int>(monkeys.monkeys_if_true[m]) << std::endl;
+        aoc::out() << "Monkey if false: " << static_cast<int>(monkeys.monkeys_if_false[m]) << std::endl;
     }
-};
-
-void get_data(const std::string&, std::vector<Monkey>&); 
-void solve_part_one(std::vector<Monkey>); 
-void solve_part_two(std::vector<Monkey>); 
-
-
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 11 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test; 
-    std::vector<Monkey> monkeys; 
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
-
-    get_data(file_name, monkeys); 
+}
 
-    if (is_test) {
-        for (const auto& m: monkeys) {
-            m.to_string(); 
-        }
-    }
+void part_one() { solve_part_one(); }
+void part_two() { solve_part_two(); }
 
-    solve_part_one(monkeys); 
-    solve_part_two(monkeys); 
+// "--rounds N" sets the number of rounds of part two 
+void set_rounds(std::string_view n) { n_rounds_part_two = aoc::to_int<size_t>(n); }
 
-    return 0; 
-}
+extern const aoc::Day day{11, load, print, part_one, part_two, {
+    {"--rounds", true, set_rounds}
+}}; 
 
-void get_data(const std::string& file_name, std::vector<Monkey>& monkeys) {
-    std::ifstream input_file{file_name}; 
+void get_data(const std::string& file_name, Monkeys& monkeys, std::vector<Item>& items) {
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        // This map keeps track of the value monkeys that will receive the items from the key monkey
-        // It will be used after the file is read to assign the monkeys with the corresponding
-        // class function
-        std::unordered_map<long int, std::pair<long int, long int>> tmp_monkeys_mapping; 
-        std::queue<long int> monkey_items; 
-        bool is_multiplicative{false}; // establishes whether the worry function is additive (false) or multiplicative (true)
-        int monkey_number; 
-        long int test_value, parameter_value = -1; 
-        long int pos_monkey_number, neg_monkey_number; 
-
-        while (std::getline(input_file, line)) {
+        uint8_t monkey_number{0}; 
+
+        for (auto line: input_file.lines()) {
             if (line.empty()) continue; 
-            std::istringstream line_stream{line}; 
-            std::string tmp_data; 
 
             if (line.find("Monkey") == 0) {
-                line_stream >> tmp_data; 
-                line_stream >> monkey_number;  
-                continue; 
+                monkey_number = static_cast<uint8_t>(monkeys.size()); 
             } else if (line.find("Starting") == 2) {
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                long int tmp_item_value;
-                while(line_stream >> tmp_item_value) { 
-                    monkey_items.push(tmp_item_value); 
-                    line_stream >> tmp_data; 
-                }
-                continue; 
+                uint64_t worry_level;
+                while (aoc::next_int(line, worry_level)) items.push_back({monkey_number, worry_level}); 
             } else if (line.find("Operation") == 2) {
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                is_multiplicative = (tmp_data == "*"); 
-                line_stream >> tmp_data; 
-                if (tmp_data != "old") parameter_value = std::stoi(tmp_data); 
-                continue; 
+                // "  Operation: new = old <op> <operand>", where "old + old" is the same as "old * 2" 
+                line.remove_prefix(line.find("old") + 4); 
+                bool is_multiplicative = (aoc::next_field(line) == "*"); 
+                if (line == "old") {
+                    monkeys.operations.push_back(is_multiplicative ? Operation::square : Operation::multiply); 
+                    monkeys.operands.push_back(is_multiplicative ? 0 : 2); 
+                } else {
+                    monkeys.operations.push_back(is_multiplicative ? Operation::multiply : Operation::add); 
+                    monkeys.operands.push_back(aoc::to_int<uint64_t>(line)); 
+                }
             } else if (line.find("Test") == 2) {
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                line_stream >> tmp_data; 
-                line_stream >> test_value; 
-                continue; 
+                uint64_t test_value; 
+                aoc::next_int(line, test_value); 
+                monkeys.test_values.push_back(test_value); 
             } else if (line.find("If true") == 4) {
-                for (size_t i = 0; i < 5; ++i) line_stream >> tmp_data; 
-                line_stream >> pos_monkey_number;
-                continue; 
+                int monkey; 
+                aoc::next_int(line, monkey); 
+                monkeys.monkeys_if_true.push_back(static_cast<uint8_t>(monkey)); 
             } else if (line.find("If false") == 4) {
-                for (size_t i = 0; i < 5; ++i) line_stream >> tmp_data; 
-                line_stream >> neg_monkey_number;
-
-                // Create the monkey and reset quantities for the next monkey
-                Monkey monkey = Monkey(monkey_number, test_value, std::move(monkey_items), pos_monkey_number, neg_monkey_number); 
-                if (is_multiplicative) monkey.set_worry_function(multiplicative_worry_function); 
-                if (parameter_value >= 0) monkey.set_worry_function_parameter(parameter_value); 
-                monkeys.push_back(monkey); 
-
-                while (!monkey_items.empty()) monkey_items.pop(); 
-                parameter_value = -1; 
+                int monkey; 
+                aoc::next_int(line, monkey); 
+                monkeys.monkeys_if_false.push_back(static_cast<uint8_t>(monkey)); 
             }
         }
     } else {
@@ -219,60 +130,149 @@ void get_data(const std::string& file_name, std::vector<Monkey>& monkeys) {
         exit(0); 
     }
 
-    input_file.close(); 
-
 } 
 
-// Approach: given the number of rounds and a specific worry relief as an input, 
-// plays multiple rounds of keep away by calling the inpspect_and_throw_items function 
-// of the monkey class. A vector of the same size of the monkeys keeps track of the 
-// number of items each monkey inspects. 
-// For part 2: to avoid too large level of worries, the worry relief is calculated by 
-// multiplying all the monkey divisors, which will be handled as a modulo operator in 
-// the inspect_and_throw_items function.
-auto play_keep_away(std::vector<Monkey> monkeys, long int worry_relief, size_t n_rounds) {
+// How the worry levels are kept manageable: divided by the worry relief after each inspection (part one), 
+// or otherwise kept modulo the product of the test values (part two). Part one cannot be reduced modulo 
+// anything: the floor division needs the worry level modulo 3 * M to give it modulo M, and then modulo 9 * M 
+// for the next inspection, and so on. So its worry levels are exact, and a level which does not fit in 
+// 64 bits is reported as an error rather than wrapped around 
+struct WorryRelief {
+    uint64_t divisor; 
+    uint64_t modulus; 
+}; 
 
-    std::vector<size_t> n_ispected_items(monkeys.size(), 0);
-    bool divideByWorryLevel = true; 
-
-    // If there's no worry relief, we need to find an alternative way to manage worry levels - 
-    // So we find the least common multiple of all test values and use that as mod operator
-    // for the items' worry levels. Note that we are dealing with only prime numbers, 
-    // so we take the multiplication of such values as LCM
-    if (worry_relief == 0) {
-        long int tmp{1}; 
-        for (auto& m: monkeys) {
-            tmp *= m.get_test_value(); 
+// Plays one round for a single item: the item is inspected by the monkey holding it, and then by every 
+// monkey it is thrown to, as long as that monkey comes later in the round. n_inspections (if not null) 
+// counts the inspections of every monkey 
+Item play_round(const Monkeys& monkeys, Item item, const WorryRelief& relief, size_t* n_inspections) {
+    auto m = item.monkey; 
+    auto worry_level = item.worry_level; 
+
+    while (true) {
+        if (n_inspections) ++n_inspections[m]; 
+        bool overflows = false; 
+        switch (monkeys.operations[m]) {
+            case Operation::add: overflows = __builtin_add_overflow(worry_level, monkeys.operands[m], &worry_level); break; 
+            case Operation::multiply: overflows = __builtin_mul_overflow(worry_level, monkeys.operands[m], &worry_level); break; 
+            case Operation::square: overflows = __builtin_mul_overflow(worry_level, worry_level, &worry_level); break; 
+        }
+        if (overflows) throw std::overflow_error("a worry level does not fit in 64 bits"); 
+        if (relief.divisor > 1) worry_level /= relief.divisor; 
+        else worry_level %= relief.modulus; 
+
+        auto next_monkey = worry_level % monkeys.test_values[m] == 0 ? monkeys.monkeys_if_true[m] : monkeys.monkeys_if_false[m]; 
+        bool is_same_round = next_monkey > m; 
+        m = next_monkey; 
+        if (!is_same_round) return {m, worry_level}; 
+    }
+}
+
+Item play_rounds(const Monkeys& monkeys, Item item, const WorryRelief& relief, size_t n_rounds, size_t* n_inspections) {
+    for (size_t r = 0; r < n_rounds; ++r) item = play_round(monkeys, item, relief, n_inspections); 
+    return item; 
+}
+
+// Counts the inspections of every monkey for a single item over n_rounds rounds. With a modulus, the 
+// cycle of the states of the item is found with Brent's algorithm (in constant memory): if the cycle 
+// starts after mu rounds and is lambda rounds long, only mu + lambda + (n_rounds - mu) % lambda rounds 
+// are simulated with counting, and the inspections of a whole cycle are multiplied by the number of cycles 
+std::vector<size_t> count_inspections(const Monkeys& monkeys, Item item, const WorryRelief& relief, size_t n_rounds) {
+    std::vector<size_t> n_inspections(monkeys.size(), 0); 
+    auto next = [&](Item i) { return play_round(monkeys, i, relief, nullptr); }; 
+
+    if (relief.divisor <= 1) {
+        // Find the length of the cycle (lambda), giving up after n_rounds rounds 
+        size_t power = 1, lambda = 1, n_steps = 1; 
+        auto tortoise = item, hare = next(item); 
+        while (tortoise != hare && n_steps < n_rounds) {
+            if (power == lambda) {
+                tortoise = hare; 
+                power *= 2; 
+                lambda = 0; 
+            }
+            hare = next(hare); 
+            ++lambda; 
+            ++n_steps; 
+        }
+
+        if (tortoise == hare) {
+            // Find where the cycle starts (mu) 
+            size_t mu = 0; 
+            tortoise = hare = item; 
+            for (size_t i = 0; i < lambda; ++i) hare = next(hare); 
+            while (tortoise != hare) {
+                tortoise = next(tortoise); 
+                hare = next(hare); 
+                ++mu; 
+            }
+
+            if (mu + lambda < n_rounds) {
+                auto cycle_start = play_rounds(monkeys, item, relief, mu, n_inspections.data()); 
+                std::vector<size_t> n_cycle_inspections(monkeys.size(), 0); 
+                play_rounds(monkeys, cycle_start, relief, lambda, n_cycle_inspections.data()); 
+                auto n_cycles = (n_rounds - mu) / lambda; 
+                for (size_t m = 0; m < monkeys.size(); ++m) n_inspections[m] += n_cycles * n_cycle_inspections[m]; 
+                play_rounds(monkeys, cycle_start, relief, (n_rounds - mu) % lambda, n_inspections.data()); 
+                return n_inspections; 
+            }
         }
-        worry_relief = tmp; 
-        divideByWorryLevel = false; 
     }
 
-    for (size_t i =0; i < n_rounds; ++i) {
-        for (size_t k = 0; k < monkeys.size(); k++) {
-            n_ispected_items.at(k) += monkeys.at(k).inspect_and_throw_items(worry_relief, monkeys, divideByWorryLevel); 
+    play_rounds(monkeys, item, relief, n_rounds, n_inspections.data()); 
+    return n_inspections; 
+}
+
+// Approach: simulate every item on its own (in parallel), and sum the number of inspections of each monkey 
+// over all the items. The level of monkey business is the product of the two largest counts. 
+// For part 2: to avoid too large levels of worry, the worry levels are kept modulo the product of all the 
+// test values (a common multiple of all of them, so that the tests are not affected). 
+auto play_keep_away(const Monkeys& monkeys, const std::vector<Item>& items, uint64_t worry_relief, size_t n_rounds) {
+
+    WorryRelief relief{worry_relief, 1}; 
+    for (auto t: monkeys.test_values) relief.modulus *= t; 
+
+    // The exceptions cannot leave the worker threads, so an overflow is only recorded there 
+    std::vector<std::vector<size_t>> n_inspections_by_item(items.size()); 
+    std::atomic<bool> has_overflowed{false}; 
+    aoc::parallel_for(items.size(), [&](size_t i) {
+        auto item = items[i]; 
+        if (relief.divisor <= 1) item.worry_level %= relief.modulus; 
+        try {
+            n_inspections_by_item[i] = count_inspections(monkeys, item, relief, n_rounds); 
+        } catch (const std::overflow_error&) {
+            has_overflowed = true; 
         }
+    }); 
+    if (has_overflowed) throw std::overflow_error("a worry level does not fit in 64 bits"); 
+
+    std::vector<size_t> n_ispected_items(monkeys.size(), 0);
+    for (const auto& n: n_inspections_by_item) {
+        for (size_t m = 0; m < monkeys.size(); ++m) n_ispected_items[m] += n[m]; 
     }
+    if (n_ispected_items.size() < 2) return size_t{0}; 
 
     std::partial_sort(n_ispected_items.begin(), n_ispected_items.begin() + 2, 
-        n_ispected_items.end(), std::greater<long int>());
-    auto largest1 = n_ispected_items[0];
-    auto largest2 = n_ispected_items[1];
-    return largest1 * largest2; 
+        n_ispected_items.end(), std::greater<size_t>());
+    return n_ispected_items[0] * n_ispected_items[1]; 
 
 }
 
-// Note that we have to pass the vector by value (rather than by reference)
-// as we need a fresh copy for part 2 
-void solve_part_one(std::vector<Monkey> monkeys) {
-    auto solution = play_keep_away(monkeys, 3, 20); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+void solve_part_one() {
+    auto solution = play_keep_away(monkeys, items, 3, 20); 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
-// For part two we need to remove the worry level and increase the rounds to 10000
-void solve_part_two(std::vector<Monkey> monkeys) {
-    auto solution = play_keep_away(monkeys, 0, 10000); 
-    std::cout << "The solution to part two is " << solution << std::endl; 
+// For part two we need to remove the worry relief and increase the rounds to 10000
+void solve_part_two() {
+    auto solution = play_keep_away(monkeys, items, 0, n_rounds_part_two); 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day11
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day11::day, argc, argv); 
+}
+#endif
@@ -1,210 +1,172 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <utility> 
-#include <list> 
 #include <algorithm>
-#include <map>
-#include <queue> 
-
-struct Node {
-    size_t row; 
-    size_t col; 
-    Node* parent = nullptr; 
-    Node(size_t r, size_t c): row(r), col(c) {}  
-    ~Node() {
-        if (parent != nullptr) delete parent; 
-    }
-}; 
-
-using Grid = std::vector<std::string>; 
+#include <cstdint> 
+#include <limits> 
+#include <string_view> 
 
-auto remove_from_vector = [](std::vector<char>& vec, char val) {
-    vec.erase(std::remove(vec.begin(), vec.end(), val), vec.end()); 
-}; 
+#include "day.h"
+#include "input.h"
 
-void get_data(const std::string&, Grid&); 
-void solve_part_one(Grid& grid); 
-void solve_part_two(Grid& grid); 
+namespace day12 {
 
+// The height map is stored as a single contiguous array of cells, row after row. Both parts (and the 
+// length of the shortest path from any cell) are answered by a Breadth-First-Search which starts from 
+// 'E' and walks the steps backwards: it gives the distance from every cell to 'E', and it can stop as 
+// soon as it reaches one of the starting cells of the part. 
 
-int main(int argc, char* argv[]) {
+struct HeightMap {
+    size_t n_rows = 0, n_cols = 0; 
+    std::string cells;  // the marks of the input: 'a' to 'z', 'S' and 'E' 
+    size_t end = 0;     // index of the cell marked 'E' 
+}; 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 12 <<<" << std::endl; 
+constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max(); 
 
-    std::string file_name; 
-    bool is_test; 
-    Grid grid; 
+void get_data(const std::string&, HeightMap&); 
+void solve_part_one(); 
+void solve_part_two(); 
+void print_distance_from(size_t, size_t); 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+HeightMap height_map; 
+bool print_distance = false;  // part two also prints the length of the shortest path from (from_row, from_col) 
+size_t from_row = 0, from_col = 0; 
 
-    get_data(file_name, grid); 
+void load(const std::string& file_name, bool) {
+    height_map = HeightMap{}; 
+    get_data(file_name, height_map); 
+}
 
-    if (is_test) {
-        for (const auto& row: grid) {
-            std::cout << row << std::endl; 
-        }
+void print() {
+    for (size_t row = 0; row < height_map.n_rows; ++row) {
+        aoc::out() << std::string_view(height_map.cells).substr(row * height_map.n_cols, height_map.n_cols) << std::endl; 
     }
+}
 
-    solve_part_one(grid); 
-    solve_part_two(grid); 
+void part_one() { solve_part_one(); }
+void part_two() { solve_part_two(); }
 
-    return 0; 
+// "--from ROW,COL" also prints the length of the shortest path from that cell 
+void set_from(std::string_view cell) {
+    from_row = aoc::to_int<size_t>(aoc::next_field(cell, ',')); 
+    from_col = aoc::to_int<size_t>(cell); 
+    print_distance = true; 
 }
 
-void get_data(const std::string& file_name, Grid& grid) {
-    std::ifstream input_file{file_name}; 
+extern const aoc::Day day{12, load, print, part_one, part_two, {
+    {"--from", true, set_from}
+}}; 
+
+void get_data(const std::string& file_name, HeightMap& height_map) {
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            grid.push_back(line); 
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            height_map.n_cols = line.size(); 
+            height_map.cells.append(line); 
+            ++height_map.n_rows; 
+        }
+        height_map.end = height_map.cells.find('E'); 
+        if (height_map.end == std::string::npos || height_map.cells.find('S') == std::string::npos) {
+            std::cerr << "The map has no start (S) or no end (E)." << std::endl; 
+            exit(0); 
         }
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
 
-    input_file.close(); 
-
 } 
 
-auto find_starting_points(Grid& grid, char starting_point_mark = 'S') {
-    size_t n_rows = grid.size(); 
-    std::vector<std::pair<size_t, size_t>> starting_points; 
-
-    // Find the starting position
-    size_t row{0}; 
-    while (row < n_rows) {
-        bool found = false; 
-        size_t col{0}; 
-        for (const auto& elevation: grid.at(row)) {
-            if (elevation == starting_point_mark || starting_point_mark != 'S' && elevation == 'S') {
-                std::pair<size_t, size_t> starting_point(row, col);
-                starting_points.push_back(starting_point);  
-                if (starting_point_mark == 'S') {
-                    found = true; 
-                    break; 
-                } 
-            }
-            ++col; 
-        }
-        if (found) break; 
-        ++row; 
-    }
-    return starting_points;  
+// Elevation of a cell: 'S' is at elevation 'a', and 'E' can only be reached from a cell at elevation 'z' 
+int elevation(char mark) {
+    if (mark == 'S') return 0; 
+    if (mark == 'E') return 'z' - 'a' + 1; 
+    return mark - 'a'; 
 }
 
-// Approach: Breadth-First-Search
-// Explore the new nodes level by level; at each level, add the new potential nodes to a 
-// queue. Loop through the node and update their corresponding parents at each iterations. 
-// When 'E' is reached, calculate how many steps the path took, and select the path wit the 
-// smaller number of steps. Loop until the queue is emptied, having explored all possible paths. 
-// Keep track of the explored nodes with a grid of booleans, and if a node was already 
-// explored, skip the search through that node. 
-auto explore_paths(Grid& grid, std::pair<size_t,size_t> starting_point) {
-    size_t n_rows = grid.size(), n_cols = grid.at(0).size(); 
-    auto row = starting_point.first;
-    auto col = starting_point.second; 
-
-    // This will keep track of the nodes explored in the grid: 
-    std::vector<std::vector<bool>> explored_nodes(n_rows, std::vector<bool>(n_cols, false)); 
-    size_t n_of_steps{0}; 
-    n_of_steps--; // start from the largest size_t number  
-
-
-    grid.at(row).at(col) = 'a'; // update the corresponding grid value so that it measures 'a' when exploring the paths
-    Node* current_node = new Node(row, col); 
-    auto start_row = row, start_col = col; 
-
-    std::queue<Node*> q;
-    q.push(current_node); 
-
-    while (!q.empty()) {
-        current_node = new Node(q.front()->row, q.front()->col);
-        current_node->parent = q.front()->parent; 
-        q.pop(); 
-
-        // Check the possible directions in the grid that we can visit
-        std::vector<char> directions{'u', 'd', 'l', 'r'}; 
-        if (current_node->row == 0) remove_from_vector(directions, 'u');
-        else if (current_node->row == n_rows - 1) remove_from_vector(directions, 'd'); 
-        if (current_node->col == 0) remove_from_vector(directions, 'l'); 
-        else if (current_node->col == n_cols - 1) remove_from_vector(directions, 'r'); 
-        size_t n_possible_directions = directions.size(); 
-        // Update rows and columns based on direction
-        for (const auto& d: directions) {
-            if (d == 'u') {
-                row = current_node->row - 1; 
-                col = current_node->col; 
-            } else if (d == 'd') {
-                row = current_node->row + 1; 
-                col = current_node->col;
-            } else if (d == 'l') {
-                row = current_node->row;
-                col = current_node->col - 1; 
-            } else { // d == 'r
-                row = current_node->row;
-                col = current_node->col + 1; 
-            } 
-            // If the potential destination is too elevated or already explored, skip  
-            if ((grid.at(row).at(col) > grid.at(current_node->row).at(current_node->col) + 1 &&
-                grid.at(row).at(col) != 'E') || explored_nodes.at(row).at(col)) {
-                    continue; 
-            }
-            // If the ptential destination is the arrival point, but we are in a too "low" node, skip;  
-            if (grid.at(row).at(col) == 'E' && grid.at(current_node->row).at(current_node->col) != 'z') continue; 
-            explored_nodes.at(row).at(col) = true;
-            Node* new_node = new Node(row, col); 
-            new_node->parent = current_node; 
-            q.push(new_node); 
-
-            // If we are at the final desintation, count the number of steps of the path 
-            // And update the number of steps if the path is smaller  
-            if (grid.at(new_node->row).at(new_node->col) == 'E') {
-                Node* final_node = new_node; 
-                final_node->parent = new_node->parent; 
-                
-                size_t tmp_n_of_steps{0}; 
-                while (final_node->parent != nullptr) {
-                    ++tmp_n_of_steps; 
-                    final_node = final_node->parent; 
-                } 
-                if (tmp_n_of_steps < n_of_steps) {
-                    n_of_steps = tmp_n_of_steps; 
-                }
-            }
+// Approach: Breadth-First-Search from 'E', over a flat distance array and a queue of cell indices (every cell 
+// is queued at most once, so the queue is a plain array of the size of the map). A step from a cell to its 
+// neighbour is allowed if the neighbour is at most one higher; walking backwards from a cell, a neighbour can 
+// be reached if the cell is at most one higher than the neighbour. The cells are reached in order of distance, 
+// so the search stops at the first cell marked with one of the stop marks (if any): the cells not reached yet 
+// are left UNREACHABLE. 
+std::vector<uint32_t> find_distances_to_end(const HeightMap& height_map, const std::string& stop_marks = "") {
+    const auto n_rows = height_map.n_rows, n_cols = height_map.n_cols; 
+    const auto n_cells = n_rows * n_cols; 
+    std::vector<uint32_t> distances(n_cells, UNREACHABLE); 
+    if (height_map.end >= n_cells) return distances; 
+
+    std::vector<int8_t> elevations(n_cells); 
+    for (size_t i = 0; i < n_cells; ++i) elevations[i] = static_cast<int8_t>(elevation(height_map.cells[i])); 
+
+    std::vector<size_t> queue(n_cells); 
+    size_t head = 0, tail = 0; 
+    distances[height_map.end] = 0; 
+    queue[tail++] = height_map.end; 
+
+    auto visit = [&](size_t neighbour, size_t cell) {
+        if (distances[neighbour] == UNREACHABLE && elevations[cell] <= elevations[neighbour] + 1) {
+            distances[neighbour] = distances[cell] + 1; 
+            queue[tail++] = neighbour; 
         }
+    }; 
+
+    while (head < tail) {
+        auto cell = queue[head++]; 
+        if (stop_marks.find(height_map.cells[cell]) != std::string::npos) break; 
+        auto row = cell / n_cols, col = cell % n_cols; 
+        if (row > 0) visit(cell - n_cols, cell); 
+        if (row + 1 < n_rows) visit(cell + n_cols, cell); 
+        if (col > 0) visit(cell - 1, cell); 
+        if (col + 1 < n_cols) visit(cell + 1, cell); 
     }
-
-    // Reset grid for part 2 
-    grid.at(start_row).at(start_col) = 'S'; 
-    return n_of_steps;  
+    return distances; 
 }
 
-auto find_size_best_path(Grid& grid, char starting_point) {
-    auto starting_points = find_starting_points(grid, starting_point); 
-    size_t n_steps_best_path{0}; 
-    n_steps_best_path--; 
-    for (const auto& s: starting_points) {
-        size_t tmp_n_steps_best_path = explore_paths(grid, s); 
-        if (tmp_n_steps_best_path < n_steps_best_path) n_steps_best_path = tmp_n_steps_best_path;
+// The length of the shortest path to 'E' from any of the cells with one of the given marks. If 'E' cannot 
+// be reached, the result is the largest size_t 
+size_t find_size_best_path(const std::string& starting_marks) {
+    auto distances = find_distances_to_end(height_map, starting_marks); 
+    size_t n_steps_best_path = std::numeric_limits<size_t>::max(); 
+    for (size_t i = 0; i < distances.size(); ++i) {
+        if (distances[i] != UNREACHABLE && starting_marks.find(height_map.cells[i]) != std::string::npos) {
+            n_steps_best_path = std::min<size_t>(n_steps_best_path, distances[i]); 
+        }
     }
     return n_steps_best_path; 
 }
 
-void solve_part_one(Grid& grid) {
-    auto solution = find_size_best_path(grid, 'S'); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+void solve_part_one() {
+    auto solution = find_size_best_path("S"); 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
-void solve_part_two(Grid& grid) {
-    auto solution = find_size_best_path(grid, 'a'); 
-    std::cout << "The solution to part two is " << solution << std::endl; 
+void solve_part_two() {
+    auto solution = find_size_best_path("aS"); 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
+    if (print_distance) print_distance_from(from_row, from_col); 
 }
 
+// Prints the length of the shortest path to 'E' from the given cell 
+void print_distance_from(size_t row, size_t col) {
+    auto distances = find_distances_to_end(height_map); 
+    if (row >= height_map.n_rows || col >= height_map.n_cols) {
+        aoc::out() << "The cell " << row << "," << col << " is outside the map" << std::endl; 
+    } else if (distances[row * height_map.n_cols + col] == UNREACHABLE) {
+        aoc::out() << "E cannot be reached from " << row << "," << col << std::endl; 
+    } else {
+        aoc::out() << "The shortest path from " << row << "," << col << " is " << distances[row * height_map.n_cols + col] << " steps" << std::endl; 
+    }
+}
+
+} // namespace day12
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day12::day, argc, argv); 
+}
+#endif
@@ -1,416 +1,358 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
+#include <string_view> 
 #include <vector> 
 #include <algorithm> 
+#include <cstdint> 
+#include <stdexcept> 
+#include <istream> 
+#include <cstring> 
+
+#include "day.h"
+#include "input.h"
+#include "thread_pool.h"
+
+namespace day13 {
 
 /* This has been the hardest puzzle so far. It took me quite some time to understand how to parse the 
 signals and into which data structure to store them, let alone thinking about all the possible cases 
 in which they can be compared. Eventually, with the help of Python (whose script can be found in this directory), 
 by means of which finding the right solution was pretty straightforward and quick (Python script written only for Part 1). 
 
-Eventually, I could find the solution in c++ too as follows: 
-- The signals are stored in a data structure called NestedVector, which contains a vector (called list) of other NestedVector's
-  and a vector (called elements) of unsigned int's; if the list is empty, then the elements vector contains number, while 
-  if the list is not empty then the elements vector is. This could have been more efficient by using for example a 
-  union or a std::variant 
-- The file is parsed line by line, and the function that parses the elements is called recursively in case of a vector
-  nested inside another one. If there are some isolated elements (which are recognized if they appear between a ']' and 
-  another ']', or between a '[' and another '[', or between  a ']' and a '['), then they are inserted in the "parent" 
-  NestedNode's list vectors as a NestedNode object with a single number in their elements list
-- The CompairPair function takes into account all possible cases -- see its comments for more details. */
-
-// The NestedVector class 
-struct NestedVector {
-    std::vector<NestedVector> list; 
-    std::vector<unsigned int> elements;
-
-    // Print function that helps visualize the created NestedVector (recursive calls to check inner vectors)
-    void print(int depth = 0) const {
-        std::cout << " [";
-        if (!list.empty()) {
-            for (const auto& l: list) {
-                l.print(1); 
-            }
-        } else {
-            for (auto it = elements.begin(); it != elements.end(); ++it) {
-                std::cout << *it; 
-                if (std::next(it) != elements.end()) {
-                    std::cout << ",";
-                } 
-            } 
-        }
-        std::cout << "] "; 
-        if (depth == 0) std::cout << std::endl; 
-    } 
+In the end, no data structure is needed at all: 
+- The packets are kept as they are in the input (all of them in a single string, one per line), and two packets 
+  are compared by walking their texts in lockstep, one token ('[', ']' or a number) at a time. When a number meets 
+  a '[' on the other side, the number is "promoted" to a list on the fly: it is compared with the first element of 
+  the other list, and followed by a virtual ']'. No tree is ever built and nothing is allocated. 
+- For sorting, the packets are first translated into a compact array of tokens (one 32-bit value per token, no 
+  commas and no digits to parse), which the same comparator walks many times over. */
+
+// Token codes of the tokenized packets: the numbers are stored as they are (larger numbers are rejected 
+// when the packets are read) 
+using Token = uint32_t; 
+constexpr Token OPEN = 0xFFFFFFFF; 
+constexpr Token CLOSE = 0xFFFFFFFE; 
+constexpr Token END = 0xFFFFFFFD; 
+constexpr Token MAX_NUMBER = 0xFFFFFFFC; 
+
+struct Packets {
+    std::string text;             // the packets, one per line 
+    std::vector<size_t> offsets;  // where each packet starts in the text (plus the end of the text) 
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; } 
+    std::string_view operator[](size_t i) const {
+        return std::string_view(text).substr(offsets[i], offsets[i + 1] - offsets[i] - 1); 
+    }
 }; 
 
-using PacketPair = std::pair<NestedVector, NestedVector>; 
-
-void get_data(const std::string&, std::vector<PacketPair>&); 
-void solve_part_one(std::vector<PacketPair>&); 
-void solve_part_two(const std::vector<PacketPair>& signals); 
-
-int main(int argc, char* argv[]) {
+void get_data(const std::string&, Packets&); 
+void solve_part_one(const Packets&); 
+void solve_part_two(const Packets&); 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 13 <<<" << std::endl; 
+Packets packets; 
+bool sort_packets = false;  // find the dividers by sorting all the packets, rather than by counting 
 
-    std::string file_name; 
-    bool is_test; 
-    std::vector<PacketPair> signals; 
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+void load(const std::string& file_name, bool) {
+    packets = Packets{}; 
+    get_data(file_name, packets); 
+}
 
-    get_data(file_name, signals); 
+// Prints a packet with every number which shares its list with other lists wrapped in a list of its own, 
+// e.g. "[[1],4]" is printed as " [ [1]  [4] ] " 
+void print_packet(std::string_view& packet, int depth = 0) {
+    packet.remove_prefix(1);  // '[' 
+    bool has_lists = false; 
+    int level = 0; 
+    for (auto c: packet) {
+        if (c == '[') { if (level++ == 0) has_lists = true; } 
+        else if (c == ']' && level-- == 0) break; 
+    }
 
-    if (is_test) {
-        for (const auto& s: signals) {
-            s.first.print(); 
-            std::cout << " VS " << std::endl; 
-            s.second.print(); 
-            std::cout << "-----------" << std::endl; 
+    aoc::out() << " ["; 
+    while (packet.front() != ']') {
+        if (packet.front() == ',') {
+            if (!has_lists) aoc::out() << ","; 
+            packet.remove_prefix(1); 
+        } else if (packet.front() == '[') {
+            print_packet(packet, 1); 
+        } else {
+            auto n_digits = std::min(packet.find_first_of(",]"), packet.size()); 
+            if (has_lists) aoc::out() << " [" << packet.substr(0, n_digits) << "] "; 
+            else aoc::out() << packet.substr(0, n_digits); 
+            packet.remove_prefix(n_digits); 
         }
     }
+    packet.remove_prefix(1);  // ']' 
+    aoc::out() << "] "; 
+    if (depth == 0) aoc::out() << std::endl; 
+}
 
-    solve_part_one(signals); 
-    solve_part_two(signals); 
-
-    return 0; 
+void print() {
+    for (size_t i = 0; i + 1 < packets.size(); i += 2) {
+        auto first = packets[i], second = packets[i + 1]; 
+        print_packet(first); 
+        aoc::out() << " VS " << std::endl; 
+        print_packet(second); 
+        aoc::out() << "-----------" << std::endl; 
+    }
 }
 
-/*
-    INPUT PARSER FUNCTIONS 
-*/
+void part_one() { solve_part_one(packets); }
+void part_two() { solve_part_two(packets); }
 
-// Checks if a number must be stored as an isolated NestedVector: 
-// this occurs if the first square bracket preceding it is NOT '[' and 
-// the next square bracket following it is NOT '[' 
-auto vector_is_isolated(const std::string& line, const size_t index) {
-    auto tmp_index{index}; 
-    char first_open, first_closed; 
-    while (first_open != '[' && first_open != ']') {
-        first_open = line.at(tmp_index); 
-        --tmp_index; 
-    }
-    tmp_index = index + 1; 
-    while (first_closed != '[' && first_closed != ']') {
-        first_closed = line.at(tmp_index); 
-        ++tmp_index; 
-    }
-    if (!(first_open == '[' && first_closed == ']')) return true; 
-    return false; 
+// "--sort" finds the dividers of part two by sorting all the packets 
+void set_sort(std::string_view) { sort_packets = true; }
 
+extern const aoc::Day day{13, load, print, part_one, part_two, {
+    {"--sort", false, set_sort}
+}}; 
+
+bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; } 
+
+// Removes the '\r' of the lines of a file with Windows line endings 
+std::string_view trim_line(std::string_view line) noexcept {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1); 
+    return line; 
 }
 
-// Parse each line of the input file. The level input (either 0 or 1) is useful to understand whether we are 
-// in the first, outer NestedVector level, or if we are inside an inner vector. This is useful to skip the first "["
-// so to avoid creating an extra level of children NestedVector's. 
-auto parse_nested_vector(std::string& line, int level, size_t& index) -> NestedVector {
-    NestedVector signal_vector; 
-    bool line_has_completed = false; 
-    while (!line_has_completed) {
-        char next_char = line.at(index);   
-        // Skip comma's 
-        if (next_char == ',') {
-            ++index; 
-            continue; 
-        }
-        // If we find a '[' and we are parsing the outer NestedVector, 
-        // continue; otherwise call the function recursively and push the resulting 
-        // Nested vector inside the "list" vector 
-        else if (next_char == '[') {
-            if (level == 1) { 
-                signal_vector.list.push_back(parse_nested_vector(line, 1, ++index)); 
-            } else {  
-                ++index; 
-                level = 1; 
-                continue; 
-            }
-        } 
-        // If we are finding a char: check if it must be isolated into its own NestedVector 
-        // Then parse the digits until the next character is a digit (for example to parse the 
-        // number 10), create a std::vector of such numbers and store them into the elements 
-        // vector of the corresponding parent NestedVector 
-        else if (std::isdigit(next_char)) {
-            auto is_isolated = vector_is_isolated(line, index); 
-            std::vector<unsigned int> elements; 
-            unsigned int next_number; 
-            while (true) {
-                std::string str_number;
-                while (std::isdigit(next_char)) {
-                    str_number.push_back(next_char); 
-                    if (index == line.size() - 1) break; 
-                    ++index; 
-                    next_char = line.at(index);            
-                }
-                next_number = std::stoul(str_number); 
-                elements.push_back(next_number); 
-                if (next_char == ',') {
-                    if (is_isolated) break; 
-                    ++index;
-                    next_char = line.at(index); 
-                    if (next_char == '[') {
-                        ++index; break;
-                    } 
-                } else if (next_char == ']') break;   
-            }
-            if (is_isolated) {
-                NestedVector new_nested_vector; 
-                new_nested_vector.elements = elements; 
-                signal_vector.list.push_back(new_nested_vector); 
-            } else {
-                signal_vector.elements = elements; 
-            }
-        }
-        // When we encounter a ']' either we continue (if the line has not ended)
-        // else we return the created NestedVector
-        if (line.at(index) == ']') {
-            if (index != line.size() - 1) ++index;  
-            return signal_vector; 
-        }
-        // If for some reason we end up at this point, terminate the loop 
-        if (index == line.size()) line_has_completed = true; 
+// Checks that every number of a packet fits in a token 
+void check_numbers(std::string_view packet) {
+    uint64_t number = 0; 
+    for (auto c: packet) {
+        if (!is_digit(c)) { number = 0; continue; } 
+        number = number * 10 + (c - '0'); 
+        if (number > MAX_NUMBER) throw std::out_of_range("Packet number too large in " + std::string(packet)); 
     }
-    // Return the created vector 
-    return signal_vector; 
 }
 
-// Parse the input file line by line and create the list of PacketPairs (nested vector vs. nested vector)
-// using the parser defined above
-void get_data(const std::string& file_name, std::vector<PacketPair>& signals) {
-    std::ifstream input_file{file_name}; 
+// Copy the packets (the non-empty lines of the input) into a single string, one per line 
+void get_data(const std::string& file_name, Packets& packets) {
+    aoc::InputFile input_file{file_name}; 
     if (input_file.is_open()) {
-        std::string line; 
-        std::vector<NestedVector> tmp_vectors; 
-        while (std::getline(input_file, line)) {
+        packets.text.reserve(input_file.text().size()); 
+        for (auto line: input_file.lines()) {
+            line = trim_line(line); 
             if (line.empty()) continue; 
-            size_t index = 0;
-            auto signal_vector = parse_nested_vector(line, 0, index);
-            tmp_vectors.push_back(signal_vector); 
-            if (tmp_vectors.size() == 2) {
-                PacketPair signal_pair = PacketPair(tmp_vectors.at(0), tmp_vectors.at(1)); 
-                signals.push_back(signal_pair); 
-                tmp_vectors.clear();
-            } 
+            check_numbers(line); 
+            packets.offsets.push_back(packets.text.size()); 
+            packets.text.append(line); 
+            packets.text.push_back('\n'); 
         }
+        packets.offsets.push_back(packets.text.size()); 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 /*
     ALGORITHM FUNCTIONS
 */
 
-// Compares std::vectors of integers as required by the instruction: as soon as one number differs from 
-// the other, it returns 1 (if the second vector's number is smaller) or -1 (if the first vector's number is smaller)
-// If the two vectors have the same number of equal elements, it returns 0; if the elements are the same, but the 
-// first vector is larger, it returns -1; else it returns 1 
-auto compare_vectors(const std::vector<unsigned int>& first, const std::vector<unsigned int>& second ) {
-    auto v1 = first.begin(), v2 = second.begin(); 
-    while(true) {
-        if (v1 == first.end() && v2 == second.end()) {
-            return 0; 
-        }
-        else if (v1 == first.end() && v2 != second.end()) return 1; 
-        else if (v1 != first.end() && v2 == second.end()) return -1;  
-
-        if (*v1 == *v2) {
-            ++v1; ++v2; continue; 
-        } 
-        else if (*v1 > *v2) return -1; 
-        else return 1; 
+// Reads the tokens of a packet from its text, skipping the commas (and any other byte which is not part of a token) 
+class TextCursor {
+    std::string_view text_; 
+    size_t pos_ = 0; 
+
+    public: 
+    explicit TextCursor(std::string_view text) noexcept : text_(text) {}
+
+    Token next() noexcept {
+        while (pos_ < text_.size() && text_[pos_] != '[' && text_[pos_] != ']' && !is_digit(text_[pos_])) ++pos_; 
+        if (pos_ == text_.size()) return END; 
+        auto c = text_[pos_]; 
+        if (c == '[') { ++pos_; return OPEN; } 
+        if (c == ']') { ++pos_; return CLOSE; } 
+        Token number = 0; 
+        while (pos_ < text_.size() && is_digit(text_[pos_])) number = number * 10 + (text_[pos_++] - '0'); 
+        return number; 
     }
-}
+}; 
 
-// Compares a pair of NestedVectors according to the requirements. All possible cases are 
-// analyzed and given in the comments. This function calls itself recursively in case of 
-// inner vectors comparison 
-auto compare_pair(NestedVector& first, NestedVector& second) -> int {
-    // Extract all the elements from each NestedVector 
-    // Extract the lists' and elements' sizes 
-    auto& e1 = first.elements; auto& e2 = second.elements; 
-    auto s1 = e1.size(), s2 = e2.size(); 
-    auto n1 = first.list.size(), n2 = second.list.size(); 
-    auto& l1 = first.list; auto& l2 = second.list; 
-    size_t index1 = 0, index2 = 0; 
-
-    // Case 1: both lists are empty
-    if (n1 == 0 && n2 == 0) {
-        if (s1 > 0 || s2 > 0) { 
-            // Case 1a: the two numeric vectors are populated 
-            auto result = compare_vectors(e1, e2);
-            return result; 
-        }  
-        else if (s1 > 0 && s2 == 0) return -1; // Case 1b: only the first inner vector contains numbers
-        else if (s1 == 0 && s2 > 0) return 1; // Case 1c: only the second inner vector contains numbers 
-        else return 0; // Both vectors are empty 
-    } 
-    // Case 2: the first NestedVector's list contains more elements than the second
-    else if (n1 >= n2) {
-        int result; 
-        // Case 2a: the second NestedVector does not contain NestedVector's 
-        if (n2 == 0) {
-            // Case 2ai: the second NestedVector's elements object contains numbers 
-            if (s2 > 0) {
-                result = compare_pair(l1.at(0), second); 
-                if (result != 0) return result; 
-                else return -1; // n1 > n2 = 0 
-            } 
-            else return -1;  // Case 2aii: the second NestedVector's elements object does not contain numbers 
-        }
+// Reads the tokens of a tokenized packet 
+class TokenCursor {
+    const Token* pos_; 
 
-        // Case 2b: List vs. number 
-        // (the first NestedVector contains other NestedVectors, but the second one only contains numbers)
-        // In this case insert each number into its own NestedVector and compare such nested vector 
-        // against the NestedVectors of the first object. Do this one by one 
-        // It returns 1 if the comparison is 0 but the second NestedVector input has more elements 
-        // than the one it is compared against  
-        if (n1 > 1 && n2 == 1 && (l2.at(0).list.size() == 0 && l2.at(0).elements.size() >= 1)) {
-            for (size_t i = 0; i < l2.at(0).elements.size(); ++i) {
-                NestedVector nv;
-                nv.elements =  std::vector<unsigned int>(1, l2.at(0).elements.at(i));
-                result = compare_pair(l1.at(i), nv);  
-                if (result != 0) return result; 
-                if (result == 0 && l2.at(0).elements.size() > l1.at(0).elements.size()) return 1; 
-            }
-        }
+    public: 
+    explicit TokenCursor(const Token* tokens) noexcept : pos_(tokens) {}
 
-        // Case 2c: list vs. list -> it loops through the lists of the two input NestedVector's
-        // std::vector<NestedVector> ll1(l1.begin(), l1.end()); 
-        // std::vector<NestedVector> ll2(l2.begin(), l2.end()); 
-        for (size_t ind = 0; ind < n2; ++ind) {
-            // Case 2ci: The current inner NestedVector of the second input list contains only numbers 
-            // (in which case wrap it with a new NestedVector and insert it into the list to allow for recursive call 
-            // of the comparison function)
-            if (l1.at(ind).list.size() > 0 && l2.at(ind).list.size() == 0 && l2.at(ind).elements.size() > 0) {
-                NestedVector nv; 
-                nv.list.push_back(l2.at(ind)); 
-                l2.at(ind) = nv; 
-            }
-            // Case 2cii: The current inner NestedVector of the first input list contains only numbers
-            // (in which case wrap it with a new NestedVector and insert it into the list to allow for recursive call 
-            // of the comparison function)
-            else if (l2.at(ind).list.size() > 0 && l1.at(ind).list.size() == 0 && l1.at(ind).elements.size() > 0) {
-                NestedVector nv; 
-                nv.list.push_back(l1.at(ind)); 
-                l1.at(ind) = nv; 
-            }
-            result = compare_pair(l1.at(ind), l2.at(ind)); 
-            if (result != 0) return result; 
-        }
-        // Case 2d: If all tests so far led to lists' equality, check the lists' size
-        if (n1 > n2) return -1;             
-        else return 0; // n1 == n2 case 
-    }
+    Token next() noexcept { return *pos_++; }
+}; 
 
-    // Case 3: the second NestedVector's list contains more elements than the first (n2 > n1)
-    // This case is the mirrored version of Case 2 
-    int result; 
-    if (n1 == 0) {
-        if (s1 > 0) {
-            result = compare_pair(first, l2.at(0)); 
-            if (result != 0) return result;
-            else return 1; // n2 > n1 = 0  
-        } 
-        else return 1; 
+// Adds the virtual list promotion to a cursor: after promote(), the number just read is read again, and 
+// then followed by a (virtual) ']' 
+template <typename Cursor> 
+class PromotingCursor {
+    Cursor cursor_; 
+    Token number_ = 0; 
+    int n_virtual_closes_ = 0; 
+    bool replay_ = false; 
+
+    public: 
+    explicit PromotingCursor(Cursor cursor) noexcept : cursor_(cursor) {}
+
+    Token next() noexcept {
+        if (replay_) { replay_ = false; return number_; } 
+        if (n_virtual_closes_ > 0) { --n_virtual_closes_; return CLOSE; } 
+        return number_ = cursor_.next(); 
     }
 
-    // List vs. number 
-    if (n2 > 1 && n1 == 1 && (l1.at(0).list.size() == 0 && l1.at(0).elements.size() >= 1)) {
-        for (size_t i = 0; i < l1.at(0).elements.size(); ++i) {
-            NestedVector nv;
-            nv.elements =  std::vector<unsigned int>(1,l1.at(0).elements.at(i));
-            result = compare_pair(nv, l2.at(i));  
-            if (result != 0) return result; 
-            if (result == 0 && l1.at(0).elements.size() > l2.at(0).elements.size()) return -1; 
-        }
+    void promote() noexcept {
+        replay_ = true; 
+        ++n_virtual_closes_; 
     }
+}; 
 
-    // List vs. list 
-    // std::vector<NestedVector> ll1(l1.begin(), l1.end()); 
-    // std::vector<NestedVector> ll2(l2.begin(), l2.end());  
-    for (size_t ind = 0; ind < n1; ++ind) {
-        if (l1.at(ind).list.size() > 0 && l2.at(ind).list.size() == 0 && l2.at(ind).elements.size() > 0) {
-            NestedVector nv; 
-            nv.list.push_back(l2.at(ind)); 
-            l2.at(ind) = nv; 
-        }
-        else if (l2.at(ind).list.size() > 0 && l1.at(ind).list.size() == 0 && l1.at(ind).elements.size() > 0) {
-            NestedVector nv; 
-            nv.list.push_back(l1.at(ind)); 
-            l1.at(ind) = nv; 
+// Compares two packets as required by the instructions, walking them in lockstep: it returns a negative 
+// number if the first packet comes first (i.e. the pair is in the right order), a positive number if the 
+// second one does, and 0 if they are the same. 
+// - two numbers are compared by value; 
+// - the packet whose list ends first (']' against anything else) comes first; 
+// - a number against a '[' is promoted to a list holding only that number. 
+template <typename Cursor> 
+int compare_packets(Cursor first_cursor, Cursor second_cursor) noexcept {
+    PromotingCursor<Cursor> first(first_cursor), second(second_cursor); 
+    while (true) {
+        auto t1 = first.next(), t2 = second.next(); 
+        if (t1 == t2) {
+            if (t1 == END) return 0; 
+            continue; 
         }
-        result = compare_pair(l1.at(ind), l2.at(ind)); 
-        if (result != 0) return result; 
+        if (t1 == CLOSE || t1 == END) return -1; 
+        if (t2 == CLOSE || t2 == END) return 1; 
+        if (t1 == OPEN) second.promote(); 
+        else if (t2 == OPEN) first.promote(); 
+        else return t1 < t2 ? -1 : 1; 
     }
-    return 1; 
 }
 
-// Check the input vector and return the sum of the sorted indices 
-auto find_sorted_pairs(std::vector<PacketPair>& signals) {
+int compare_packets(std::string_view first, std::string_view second) noexcept {
+    return compare_packets(TextCursor(first), TextCursor(second)); 
+}
+
+// Check the pairs of packets and return the sum of the (1-based) indices of the pairs in the right order 
+auto find_sorted_pairs(const Packets& packets) {
     size_t sum_sorted_pairs = 0; 
-    for (size_t i=0; i<signals.size(); ++i) {
-        auto result = compare_pair(signals.at(i).first, signals.at(i).second);  
-        if (result > 0) sum_sorted_pairs += (i+1); 
+    for (size_t i = 0; i + 1 < packets.size(); i += 2) {
+        if (compare_packets(packets[i], packets[i + 1]) < 0) sum_sorted_pairs += i / 2 + 1; 
     }
     return sum_sorted_pairs; 
 }   
 
-void solve_part_one(std::vector<PacketPair>& signals) {
-    auto solution = find_sorted_pairs(signals); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+void solve_part_one(const Packets& packets) {
+    auto solution = find_sorted_pairs(packets); 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
+}
+
+// Translates a packet into tokens (ending with END), appending them to the array 
+void tokenize(std::string_view packet, std::vector<Token>& tokens) {
+    TextCursor cursor(packet); 
+    for (auto token = cursor.next(); token != END; token = cursor.next()) tokens.push_back(token); 
+    tokens.push_back(END); 
 }
 
 // For part two, we write a function that: 
-// (a) stores all the NestedVector signals into one vector, rather than in pairs 
-// (b) adds the two divider packets into such vector
-// (c) uses std::sort to sort the signals according to the compare function we created for Part 1 
-auto sort_and_find_divider_indices(const std::vector<PacketPair>& signals) {
-
-    // a. store all signals in a vector
-    std::vector<NestedVector> signals_with_dividers; 
-    for (const auto& s: signals) {
-        signals_with_dividers.push_back(s.first); 
-        signals_with_dividers.push_back(s.second); 
+// (a) translates all the packets, plus the two divider packets, into a single array of tokens 
+// (b) sorts the positions of the packets in that array, comparing the tokens with the function of part 1 
+// (c) finds where the dividers ended up 
+auto sort_and_find_divider_indices(const Packets& packets) {
+
+    // a. tokenize all the packets, the dividers being the last two 
+    std::vector<Token> tokens; 
+    tokens.reserve(packets.text.size()); 
+    std::vector<uint32_t> packet_starts; 
+    packet_starts.reserve(packets.size() + 2); 
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packet_starts.push_back(static_cast<uint32_t>(tokens.size())); 
+        tokenize(packets[i], tokens); 
     }
-
-    // b. add dividers
-    std::vector<unsigned int> first_divider_element(1, 2); 
-    std::vector<unsigned int> second_divider_element(1, 6); 
-    NestedVector first_divider, second_divider; 
-    first_divider.elements = first_divider_element; 
-    second_divider.elements = second_divider_element; 
-    signals_with_dividers.push_back(first_divider); 
-    signals_with_dividers.push_back(second_divider); 
-
-    // c. sort the vector
-    std::sort(signals_with_dividers.begin(), signals_with_dividers.end(), [](NestedVector first, NestedVector second){
-        return compare_pair(first, second) > 0; 
+    const auto first_divider = static_cast<uint32_t>(tokens.size()); 
+    tokenize("[[2]]", tokens); 
+    const auto second_divider = static_cast<uint32_t>(tokens.size()); 
+    tokenize("[[6]]", tokens); 
+    packet_starts.push_back(first_divider); 
+    packet_starts.push_back(second_divider); 
+
+    // b. sort the packets; a divider goes before the packets equal to it (e.g. "[2]"), so that its index 
+    // does not depend on the sort 
+    auto is_divider = [&](uint32_t start) { return start >= first_divider; }; 
+    std::sort(packet_starts.begin(), packet_starts.end(), [&](uint32_t first, uint32_t second) {
+        auto result = compare_packets(TokenCursor(tokens.data() + first), TokenCursor(tokens.data() + second)); 
+        return result < 0 || (result == 0 && is_divider(first) && !is_divider(second)); 
     }); 
 
-    // d. find the correct indices, multiply them, and return the result 
-    size_t num_dividers_found = 0; 
+    // c. find the (1-based) indices of the dividers, and multiply them 
     size_t solution = 1; 
-    for (size_t i = 0; i < signals_with_dividers.size(); ++i) {
-        auto s = signals_with_dividers.at(i);
-        if (s.list.size() == 0 && s.elements.size() == 1 && (s.elements.at(0) == 2 || s.elements.at(0) == 6)) {
-            num_dividers_found += 1; 
-            solution *= (i+1); 
-        }
-        if (num_dividers_found == 2) break; 
+    for (size_t i = 0; i < packet_starts.size(); ++i) {
+        if (packet_starts[i] == first_divider || packet_starts[i] == second_divider) solution *= (i + 1); 
     }
     return solution; 
 }
 
-void solve_part_two(const std::vector<PacketPair>& signals) {
-    auto solution = sort_and_find_divider_indices(signals); 
-    std::cout << "The solution to part two is " << solution << std::endl; 
+// Counting mode: the index of a divider in the sorted list is 1 + the number of packets which come before it 
+// (+ 1 for the second divider, which comes after the first one). So each packet only needs to be compared with 
+// the two dividers, and nothing is sorted: O(n) time and O(1) extra memory. 
+struct DividerIndices {
+    size_t first = 1; 
+    size_t second = 2; 
+
+    // Counts the packet if it comes before either divider (anything before [[2]] is also before [[6]]) 
+    void count(std::string_view packet) noexcept {
+        if (compare_packets(packet, "[[6]]") >= 0) return; 
+        ++second; 
+        if (compare_packets(packet, "[[2]]") < 0) ++first; 
+    }
+}; 
+
+// Approach: count the packets before the dividers in a single pass, split in blocks across the threads 
+auto count_divider_indices(const Packets& packets) {
+    const size_t BLOCK_SIZE = 4096; 
+    std::vector<DividerIndices> block_indices((packets.size() + BLOCK_SIZE - 1) / BLOCK_SIZE, DividerIndices{0, 0}); 
+    aoc::parallel_for(block_indices.size(), [&](size_t b) {
+        for (size_t i = b * BLOCK_SIZE; i < std::min(packets.size(), (b + 1) * BLOCK_SIZE); ++i) block_indices[b].count(packets[i]); 
+    }); 
+
+    DividerIndices indices; 
+    for (const auto& b: block_indices) {
+        indices.first += b.first; 
+        indices.second += b.second; 
+    }
+    return indices.first * indices.second; 
+}
+
+// The same count over packets read one line at a time from a stream, which can be arbitrarily large 
+size_t count_divider_indices(std::istream& is) {
+    DividerIndices indices; 
+    std::string line; 
+    while (std::getline(is, line)) {
+        auto packet = trim_line(line); 
+        if (packet.empty()) continue; 
+        check_numbers(packet); 
+        indices.count(packet); 
+    }
+    return indices.first * indices.second; 
+}
+
+void solve_part_two(const Packets& packets) {
+    auto solution = sort_packets ? sort_and_find_divider_indices(packets) : count_divider_indices(packets); 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day13
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    // "--stdin" reads the packets from the standard input as they arrive, and only prints the solution to part two 
+    if (argc > 1 && std::strcmp(argv[1], "--stdin") == 0) {
+        try {
+            auto solution = day13::count_divider_indices(std::cin); 
+            std::cout << "The solution to part two is " << solution << std::endl; 
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl; 
+            return 1; 
+        }
+        return 0; 
+    }
+    return aoc::run_day(day13::day, argc, argv); 
+}
+#endif
@@ -1,15 +1,22 @@
 #include <iostream> 
 #include <string>
 #include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <utility> 
 #include <algorithm>
 #include <cmath>
-#include <regex>  
+#include <array> 
 #include <unordered_map> 
 #include <unordered_set> 
 #include <limits> 
+#include <iterator> 
+#include <atomic> 
+
+#include "day.h"
+#include "input.h"
+#include "thread_pool.h"
+
+namespace day15 {
 
 // Approach: rather than looping through numbers, I will use ranges (specified in the Interval struct) to 
 // solve today's puzzle. This will definitely improve the solution in term of efficiency. 
@@ -39,10 +46,12 @@ struct Sensor {
         std::string s_string= "Sensor: (" + std::to_string(coordinate.first) + ',' + std::to_string(coordinate.second) + 
             ") -> Beacon: (" + std::to_string(closest_beacon.first) + ',' + std::to_string(closest_beacon.second) + ')' + 
             ":::Manatthan Distance: " + std::to_string(distance) ;
-        std::cout << s_string << std::endl;
+        aoc::out() << s_string << std::endl;
     }
 }; 
 
+constexpr long int NOT_FOUND = -1;  // no distress beacon found (the tuning frequency is never negative) 
+
 struct Interval {
     long int inf, sup; 
 
@@ -99,7 +108,7 @@ struct Interval {
     }
 
     auto print () const {
-        std::cout << "[" << std::to_string(inf) << "," << std::to_string(sup) << "]" << std::endl; 
+        aoc::out() << "[" << std::to_string(inf) << "," << std::to_string(sup) << "]" << std::endl; 
     }
 
     auto size() const {
@@ -126,76 +135,64 @@ struct Interval {
 
 void get_data(const std::string&, std::vector<Sensor>&);  
 void solve_part_one(const std::vector<Sensor>&, long int); 
-void solve_part_two(std::vector<Sensor>&, const std::vector<long int>&); 
-
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 15 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test; 
-    std::vector<Sensor> sensors; 
-    long int row_nr = 2000000; 
+void solve_part_two(const std::vector<Sensor>&, const std::vector<long int>&); 
 
+bool is_test = false; 
+long int search_area_max = 0;  // if set, the search area of part two is 0..search_area_max in both directions 
+bool scan_rows = false;        // part two: scan the rows rather than searching from the boundaries of the sensors 
+std::vector<Sensor> sensors; 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) {file_name = "./test.txt"; row_nr = 10;} 
-    else file_name = "./input.txt"; 
-
+void load(const std::string& file_name, bool test) {
+    is_test = test; 
+    sensors.clear(); 
     get_data(file_name, sensors); 
+}
 
-    if (is_test) {
-        for (const auto& s: sensors) s.print(); 
-    }
+void print() {
+    for (const auto& s: sensors) s.print(); 
+}
 
+void part_one() {
+    long int row_nr = is_test ? 10 : 2000000; 
     solve_part_one(sensors, row_nr); 
+}
 
+void part_two() {
     std::vector<long int> extremes{0, 4000000, 0, 4000000};
     if (is_test) {
         extremes = {0, 20, 0, 20};
     } 
+    if (search_area_max > 0) extremes = {0, search_area_max, 0, search_area_max}; 
     solve_part_two(sensors, extremes); 
-
-    return 0; 
 }
 
-// Just for a change, the data will be imported using regular expression pattern matching 
+// "--area MAX" sets the search area of part two to 0..MAX, and "--scan" finds the distress beacon by scanning 
+// the rows 
+void set_area(std::string_view max) { search_area_max = aoc::to_int<long int>(max); }
+void set_scan(std::string_view) { scan_rows = true; }
+
+extern const aoc::Day day{15, load, print, part_one, part_two, {
+    {"--area", true, set_area}, 
+    {"--scan", false, set_scan}
+}}; 
+
+// Each line is "Sensor at x=<sx>, y=<sy>: closest beacon is at x=<bx>, y=<by>": the four numbers are collected 
+// by the shared line scanner 
 void get_data(const std::string& file_name, std::vector<Sensor>& sensors) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        std::regex pattern("Sensor at x=(-?\\d+), y=(-?\\d+): closest beacon is at x=(-?\\d+), y=(-?\\d+)"); 
-        std::smatch match; 
-        while (std::getline(input_file, line)) {
-            std::string::const_iterator search_it(line.cbegin());
-            // This would be used to loop through the groups to search, e.g. if the pattern was 
-            // "x=(-?\\d+), y=(-?\\d+)"
-            // while (std::regex_search(search_stream, line.cend(), match, pattern)) {
-            //     if (match.size() == 3) {
-            //         long int sx = std::stoi(match[1].str()); 
-            //         long int sy = std::stoi(match[2].str()); 
-            //         // long int bx = std::stoi(match[3].str());
-            //         // long int by = std::stoi(match[4].str());
-            //         search_stream = match.suffix().first;
-            //         // Sensor sensor(sx, sy, bx, by); 
-            //         // sensors.push_back(sensor); 
-            //     }
-            // }
-            if (std::regex_search(search_it, line.cend(), match, pattern) && match.size() == 5) {
-                    long int sx = std::stoi(match[1].str()); 
-                    long int sy = std::stoi(match[2].str()); 
-                    long int bx = std::stoi(match[3].str());
-                    long int by = std::stoi(match[4].str()); 
-                    Sensor sensor(sx, sy, bx, by); 
-                    sensors.push_back(sensor); 
+        std::array<long int, 4> numbers; 
+        for (auto line: input_file.lines()) {
+            if (aoc::scan_ints<long int>(line, numbers) == 4) {
+                Sensor sensor(numbers[0], numbers[1], numbers[2], numbers[3]); 
+                sensors.push_back(sensor); 
             } 
         }
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -262,24 +259,24 @@ auto detect_empty_positions_for_row(const std::vector<Sensor>& sensors, long int
     number_empty_positions += int_.size(); 
 
     // FOR DEBUGGING: 
-    // std::cout << "Sorted intervals: " << std::endl; 
+    // aoc::out() << "Sorted intervals: " << std::endl; 
     // for (const auto& e: row_empty_coordinates) {
     //     e.print(); 
-    //     std::cout << e.size() << std::endl; 
+    //     aoc::out() << e.size() << std::endl; 
     // }
 
-    // std::cout << "Extended intervals: " << std::endl; 
+    // aoc::out() << "Extended intervals: " << std::endl; 
     // for (const auto& e: extended_intervals) {
     //     e.print(); 
-    //     std::cout << e.size() << std::endl;
+    //     aoc::out() << e.size() << std::endl;
     // }
 
 
     // for (long int i = 9; i <= 11; ++i) {
     //     for (const auto& e: empty_coordinates[i]) {
-    //         std::cout << std::to_string(e) << " "; 
+    //         aoc::out() << std::to_string(e) << " "; 
     //     }
-    //     std::cout << std::endl;
+    //     aoc::out() << std::endl;
     // }
 
     // Last, we need to check if a sensor or a beacon are in the interval's coordinates, 
@@ -319,67 +316,201 @@ auto detect_empty_positions_for_row(const std::vector<Sensor>& sensors, long int
 
 void solve_part_one(const std::vector<Sensor>& sensors, long int row_nr) {
     auto solution = detect_empty_positions_for_row(sensors, row_nr); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
-auto find_distress_signal(std::vector<Sensor>& sensors, const std::vector<long int>& extremes) -> long int{
+// Scans a row of the search area: merges the ranges of the sensors on the row (collected into a buffer which is 
+// reused from row to row) and returns the first column which none of them covers, or NOT_FOUND. 
+// If the row is fully covered, rows_to_skip is set to the number of following rows which are certainly covered 
+// too. Every end of a range moves by at most one column per row, so the chain of ranges which covers the row 
+// keeps covering the following rows as long as the overlap between two consecutive ranges of the chain (which 
+// shrinks by at most 2 per row) and the overhang of the chain over the edges of the area (by at most 1 per 
+// row) do not run out. This holds even after a range of the chain has vanished. 
+auto scan_row(const std::vector<Sensor>& sensors, long int row_nr, long int max_left, long int max_right, 
+              std::vector<std::pair<long int, long int>>& ranges, long int& rows_to_skip) -> long int {
+
+    ranges.clear(); 
+    for (const auto& s: sensors) {
+        auto horizontal_extension = s.distance - std::abs(s.coordinate.second - row_nr); 
+        if (horizontal_extension < 0) continue; 
+        ranges.emplace_back(s.coordinate.first - horizontal_extension, s.coordinate.first + horizontal_extension); 
+    }
+    std::sort(ranges.begin(), ranges.end()); 
+
+    // The columns up to reach are covered 
+    long int reach = max_left - 1; 
+    bool is_first_link = true; 
+    rows_to_skip = std::numeric_limits<long int>::max(); 
+    for (const auto& r: ranges) {
+        if (r.first > reach + 1) break; 
+        if (r.second <= reach) continue; 
+        auto overlap = reach + 1 - r.first; 
+        rows_to_skip = std::min(rows_to_skip, is_first_link ? overlap : overlap / 2); 
+        is_first_link = false; 
+        reach = r.second; 
+        if (reach >= max_right) break; 
+    }
+
+    if (reach < max_right) return reach + 1; 
+    rows_to_skip = std::min(rows_to_skip, reach - max_right); 
+    return NOT_FOUND; 
+}
+
+// Row sweep: the rows of the search area are split in blocks, which are scanned in parallel; each worker reuses 
+// its own buffer of ranges, and skips ahead over the rows which are certainly covered. As soon as a worker finds 
+// the gap, the rows below it are no longer scanned (the gap in the topmost row wins, if there were several) 
+auto scan_for_distress_signal(const std::vector<Sensor>& sensors, const std::vector<long int>& extremes) -> long int{
 
     auto max_left = extremes.at(0); 
     auto max_right = extremes.at(1); 
     auto max_up = extremes.at(2); 
     auto max_down = extremes.at(3); 
+    if (max_down < max_up || max_right < max_left) return NOT_FOUND; 
+
+    const auto n_rows = static_cast<size_t>(max_down - max_up) + 1; 
+    const size_t n_blocks = std::min<size_t>(n_rows, aoc::default_concurrency() * 16); 
+    const auto block_size = static_cast<long int>((n_rows + n_blocks - 1) / n_blocks); 
+
+    std::atomic<long int> found_row{std::numeric_limits<long int>::max()}; 
+    std::vector<long int> found_col(n_blocks, NOT_FOUND); 
+
+    aoc::parallel_for(n_blocks, [&](size_t b) {
+        thread_local std::vector<std::pair<long int, long int>> ranges; 
+        auto first_row = max_up + static_cast<long int>(b) * block_size; 
+        auto last_row = std::min(max_down, first_row + block_size - 1); 
+
+        for (auto row_nr = first_row; row_nr <= last_row && row_nr < found_row.load(std::memory_order_relaxed);) {
+            long int rows_to_skip = 0; 
+            auto col = scan_row(sensors, row_nr, max_left, max_right, ranges, rows_to_skip); 
+            if (col != NOT_FOUND) {
+                found_col[b] = col; 
+                auto best_row = found_row.load(); 
+                while (row_nr < best_row && !found_row.compare_exchange_weak(best_row, row_nr)); 
+                return; 
+            }
+            row_nr += 1 + rows_to_skip; 
+        }
+    }); 
+
+    auto row_nr = found_row.load(); 
+    if (row_nr > max_down) return NOT_FOUND; 
+    auto col = found_col[static_cast<size_t>((row_nr - max_up) / block_size)]; 
+    return col * 4000000 + row_nr; 
+
+}
 
-    // Loop across each of the possible rows (max_up to max_down)
-    for (size_t row_nr = max_up; row_nr <= max_down; ++row_nr) {
-        std::vector<Interval> row_empty_coordinates; 
+// For the search from the boundaries: the sensors as a structure of arrays, so that the test of a point against 
+// all of them is a plain loop over contiguous numbers 
+struct SensorFields {
+    std::vector<long int> x, y, radius; 
 
-        // For the current row, check all the interval of the empty positions 
+    explicit SensorFields(const std::vector<Sensor>& sensors) {
         for (const auto& s: sensors) {
-            find_sensor_reception_field(s, row_empty_coordinates, row_nr, max_left, max_right); 
+            x.push_back(s.coordinate.first); 
+            y.push_back(s.coordinate.second); 
+            radius.push_back(s.distance); 
         }
+    }
 
-        // Sort the intervals in the ascending orders and, as done for part 1, 
-        // avoid overlapping intervals by extending the first one 
-        std::sort(row_empty_coordinates.begin(), row_empty_coordinates.end()); 
-        long int number_empty_positions = 0; 
-        Interval int_ = row_empty_coordinates.at(0);
-        std::vector<Interval> extended_intervals; 
-        size_t ind = 1; 
-        while (ind < row_empty_coordinates.size()) {
-            auto new_int_ = row_empty_coordinates.at(ind); 
-
-            if (int_.extend(new_int_)) {
-                ++ind; 
-                continue; 
-            }
+    // Checks if a point is within the range of any sensor. There is no early exit, so that the compiler 
+    // can vectorize the loop 
+    bool covers(long int px, long int py) const noexcept {
+        int covered = 0; 
+        for (size_t i = 0; i < x.size(); ++i) covered |= (std::abs(px - x[i]) + std::abs(py - y[i]) <= radius[i]); 
+        return covered != 0; 
+    }
+}; 
 
-            extended_intervals.push_back(int_); 
-            number_empty_positions += int_.size(); 
-            int_ = new_int_; 
-            ++ind; 
-        } 
+// Search from the boundaries: the distress beacon is the only position of the search area which no sensor covers, 
+// so (unless it is on the edge of the area) it lies just outside the range of several sensors, on the boundary lines 
+// of their diamonds (at distance radius + 1). In the rotated coordinates u = x + y and v = x - y these lines are 
+// u = const and v = const, so the candidates are the intersections of a u line and a v line. Only the lines shared 
+// by two sensors (on the far side of one and the near side of the other) are considered first, which leaves a 
+// handful of candidates; then the intersections of all the boundary lines with the edges of the search area. 
+// Each candidate is checked against all the sensors. Returns NOT_FOUND if no candidate is uncovered. 
+auto search_boundaries_for_distress_signal(const std::vector<Sensor>& sensors, const std::vector<long int>& extremes) -> long int {
 
-        extended_intervals.push_back(int_);
-        number_empty_positions += int_.size(); 
+    auto max_left = extremes.at(0); 
+    auto max_right = extremes.at(1); 
+    auto max_up = extremes.at(2); 
+    auto max_down = extremes.at(3); 
+    const SensorFields fields(sensors); 
+
+    // The boundary lines: lower and upper u and v lines of each diamond 
+    std::vector<long int> u_lower, u_upper, v_lower, v_upper; 
+    for (const auto& s: sensors) {
+        auto u = s.coordinate.first + s.coordinate.second, v = s.coordinate.first - s.coordinate.second; 
+        u_lower.push_back(u - s.distance - 1); 
+        u_upper.push_back(u + s.distance + 1); 
+        v_lower.push_back(v - s.distance - 1); 
+        v_upper.push_back(v + s.distance + 1); 
+    }
+    for (auto* lines: {&u_lower, &u_upper, &v_lower, &v_upper}) {
+        std::sort(lines->begin(), lines->end()); 
+        lines->erase(std::unique(lines->begin(), lines->end()), lines->end()); 
+    }
+
+    auto shared_lines = [](const std::vector<long int>& lower, const std::vector<long int>& upper) {
+        std::vector<long int> shared; 
+        std::set_intersection(lower.begin(), lower.end(), upper.begin(), upper.end(), std::back_inserter(shared)); 
+        return shared; 
+    }; 
 
-        // Now check that the final extended interval does not leave non-empty positions: 
-        // if there is one empty position we have found the row containing the distressed signal 
-        // The column will simply be the superior extreme of the first interval + 1 (a non-empty position)
-        // After that we can calculate the corresponding tuning frequency
-        if (number_empty_positions != std::abs(max_right-max_left)+1) { 
-            auto col = extended_intervals.at(0).sup + 1; 
-            // std::cout << "X: " << col << " Y: " << row_nr << std::endl; 
-            return col * 4000000 + row_nr; 
+    auto is_distress_beacon = [&](long int x, long int y) {
+        return x >= max_left && x <= max_right && y >= max_up && y <= max_down && !fields.covers(x, y); 
+    }; 
 
+    // a. Intersections of the shared lines (u + v must be even for the intersection to be on the grid) 
+    auto u_shared = shared_lines(u_lower, u_upper), v_shared = shared_lines(v_lower, v_upper); 
+    for (auto u: u_shared) {
+        for (auto v: v_shared) {
+            if ((u + v) % 2 != 0) continue; 
+            auto x = (u + v) / 2, y = (u - v) / 2; 
+            if (is_distress_beacon(x, y)) return x * 4000000 + y; 
         }
     }
-    return 0; 
 
+    // b. The corners of the search area, and the intersections of all the boundary lines with its edges 
+    std::vector<Coordinate> candidates{{max_left, max_up}, {max_left, max_down}, {max_right, max_up}, {max_right, max_down}}; 
+    for (const auto* lines: {&u_lower, &u_upper}) {
+        for (auto u: *lines) {
+            candidates.emplace_back(max_left, u - max_left); 
+            candidates.emplace_back(max_right, u - max_right); 
+            candidates.emplace_back(u - max_up, max_up); 
+            candidates.emplace_back(u - max_down, max_down); 
+        }
+    }
+    for (const auto* lines: {&v_lower, &v_upper}) {
+        for (auto v: *lines) {
+            candidates.emplace_back(max_left, max_left - v); 
+            candidates.emplace_back(max_right, max_right - v); 
+            candidates.emplace_back(v + max_up, max_up); 
+            candidates.emplace_back(v + max_down, max_down); 
+        }
+    }
+    for (const auto& c: candidates) {
+        if (is_distress_beacon(c.first, c.second)) return c.first * 4000000 + c.second; 
+    }
+    return NOT_FOUND; 
+}
+
+// Approach: search from the boundaries of the sensors' ranges, and only if that fails (which would need the distress 
+// beacon to be hidden in an unusual spot) scan the rows of the search area one by one 
+auto find_distress_signal(const std::vector<Sensor>& sensors, const std::vector<long int>& extremes) -> long int {
+    auto solution = scan_rows ? NOT_FOUND : search_boundaries_for_distress_signal(sensors, extremes); 
+    if (solution == NOT_FOUND) solution = scan_for_distress_signal(sensors, extremes); 
+    return solution == NOT_FOUND ? 0 : solution; 
 }
 
-void solve_part_two(std::vector<Sensor>& sensors, const std::vector<long int>& extremes) {
+void solve_part_two(const std::vector<Sensor>& sensors, const std::vector<long int>& extremes) {
     auto solution = find_distress_signal(sensors, extremes);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day15
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day15::day, argc, argv); 
+}
+#endif
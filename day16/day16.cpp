@@ -1,437 +1,301 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
+#include <string_view> 
 #include <vector> 
 #include <algorithm>
-#include <regex>  
 #include <unordered_map> 
-#include <unordered_set> 
 #include <limits> 
 #include <utility> 
-#include <set> 
-
-// For Day 16, I will create a Valve struct that will store all the relevant information about the input data. [Note: as the valves 
-// are stored in a std::unordered_map in which the keys are their names, the name field is not really relevant here. This must be changed then]
-// First, I will get the input data. Then I will calculate the distances between the valves using a shortest path algorithm, 
-// in this case Dijkstra (I will use a std::set as a priority queue).  
-// Then, for part one I will find the maximum relieved pressur with the use of recursion and caching (making it as a matter of fact
-// a dynamic programming solution). For part two, I will use the same simulation funciton, however I will introduce a ele_cache
-// object which keeps track of how much max relieved pressure each combination of opened valves leads to. This will be useful 
-// to find the disjoint sets of valves which maximize the relieved pressure, and allow to find the best combination of pressure
-// of the human + elephant paths within the 26 minutes. The valves with 0 flows will be skipped to speed up computations.
-
+#include <cstdint> 
+#include <stdexcept> 
+
+#include "day.h"
+#include "input.h"
+
+namespace day16 {
+
+// For Day 16, I will create a Valve struct that will store all the relevant information about the input data. The valves 
+// are stored in a vector, in the order of the input, and identified by their index in the vector (their names are only 
+// interned once, while parsing). 
+// First, I will get the input data. Then I will calculate the distances between the valves which matter (the ones with a 
+// flow, plus the starting valve AA) with a Breadth-First-Search from each of them, into a dense distance matrix. 
+// The valves with a flow are numbered from 0, so that a set of opened valves is a bitmask. Then a dynamic programming 
+// over (set of valves still to open, position) finds the cheapest order to open every set, where the cost of an order 
+// is the pressure it loses while walking; it does not depend on the time, so it gives (for any number of minutes) a 
+// flat table, indexed by the bitmask of the opened valves, of the best pressure relieved by the end with that set of 
+// valves. Part one is the maximum of the table. For part two, the human 
+// and the elephant open two disjoint sets of valves, so the solution is the best combination of two disjoint bitmasks: 
+// a subset-max transform of the table gives the best partner of every bitmask in linear time. 
 
 struct Valve {
 
     std::string name; 
-    unsigned int flow_rate; 
-    std::unordered_set<std::string> neighbors; 
-
-    explicit Valve(std::string n, unsigned int f, std::unordered_set<std::string> nb) noexcept: 
-        name(n), flow_rate(f), neighbors(nb) {}
-
-    explicit Valve(std::string n) noexcept: name(n), flow_rate(0) {
-        neighbors = std::unordered_set<std::string>(); 
-    } 
-
-    auto print() const {
-        std::cout << "Valve " << name << " : flow rate = " << std::to_string(flow_rate) << " -> "; 
-        for (const auto& v: neighbors) {
-            std::cout << "(" << v << ") "; 
-        }
-        std::cout << std::endl; 
-    }
+    unsigned int flow_rate = 0; 
+    std::vector<size_t> neighbors;  // indices of the neighboring valves 
 
-    // // The following operations are useful if we want to use the valves as keys for hash sets or maps 
-    // bool operator==(const Valve& other) const {
-    //     return this->name == other.name; 
-    // }
-
-    // struct HashFunction {
-    //     size_t operator()(const Valve& v) const {
-    //         return std::hash<std::string>()(v.name); 
-    //     }
-    // }; 
-
-};
-
-using ValvesMap = std::unordered_map<std::string, Valve>; 
-
-// The following two struct's will be used as hashing and equality functions 
-// when we will use std::unordered_set's as keys for the std::unordered_maps in Part 2 (the ele_cache). 
-struct HashSetHash {
-    size_t operator()(const std::unordered_set<std::string>& set) const {
-        std::size_t hash = 0;
-        for (const auto& element : set) {
-            hash ^= std::hash<std::string>()(element);
-        }
-        return hash;
-    }
-};
-
-struct HashSetEqual {
-    bool operator()(const std::unordered_set<std::string>& set1, const std::unordered_set<std::string>& set2) const {
-        return set1 == set2;
-    }
-};
+    explicit Valve(std::string_view n) noexcept: name(n) {} 
+}; 
 
-void get_data(const std::string&, ValvesMap&);  
-void solve_part_one(ValvesMap&); 
-void solve_part_two(ValvesMap&); 
+using Valves = std::vector<Valve>; 
 
-int main(int argc, char* argv[]) {
+// The bitmasks of the opened valves index tables of 2^(number of flowing valves) entries (times the number of 
+// flowing valves for the costs of the orders) 
+constexpr size_t MAX_FLOWING_VALVES = 20; 
 
-    std::cout << ">>> Advent Of Code 2022 - Day 16 <<<" << std::endl; 
+// The valves which matter for the search: the valves with a flow (0 to n_flowing - 1, i.e. the bits of the masks) and 
+// the starting valve (the last one), with the distances between all of them 
+struct ValveNetwork {
+    size_t n_flowing = 0; 
+    std::vector<unsigned int> flow_rates; 
+    std::vector<unsigned int> distances;  // (n_flowing + 1) x (n_flowing + 1) matrix 
 
-    std::string file_name; 
-    bool is_test; 
-    ValvesMap valves; 
+    size_t start() const { return n_flowing; } 
+    unsigned int distance(size_t from, size_t to) const { return distances[from * (n_flowing + 1) + to]; } 
+}; 
 
+void get_data(const std::string&, Valves&);  
+void solve_part_one(const Valves&); 
+void solve_part_two(const Valves&); 
 
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+Valves valves; 
 
+void load(const std::string& file_name, bool) {
+    valves.clear(); 
     get_data(file_name, valves); 
+}
 
-    if (is_test) {
-        for (const auto& v: valves) v.second.print(); 
+void print() {
+    for (const auto& v: valves) {
+        aoc::out() << "Valve " << v.name << " : flow rate = " << std::to_string(v.flow_rate) << " -> "; 
+        for (auto n: v.neighbors) aoc::out() << "(" << valves[n].name << ") "; 
+        aoc::out() << std::endl; 
     }
+}
 
-    solve_part_one(valves); 
-    solve_part_two(valves); 
+void part_one() { solve_part_one(valves); }
+void part_two() { solve_part_two(valves); }
 
-    return 0; 
-}
+extern const aoc::Day day{16, load, print, part_one, part_two}; 
 
-// Get the data, using regex 
-void get_data(const std::string& file_name, ValvesMap& valves) {
-    std::ifstream input_file{file_name}; 
+// Get the data: each line is "Valve <XX> has flow rate=<n>; tunnels lead to valves <XX>, <XX>, ...", so the 
+// shared line scanner gives the name of the valve (the first identifier), its flow rate and its neighbors. 
+// A valve gets its index the first time its name appears (possibly as a neighbor); the valves which only appear 
+// as neighbors are moved at the end afterwards, so that the valves keep the order of the input 
+void get_data(const std::string& file_name, Valves& valves) {
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        std::regex pattern(R"(Valve ([A-Z]{2}) has flow rate=(\d+); \btunnels?\b \bleads?\b to \bvalves? (([A-Z]+, ?)*[A-Z]+))"); 
-        std::smatch match; 
-        while (std::getline(input_file, line)) {
-            std::unordered_set<std::string> neighboring_valves; 
-            std::string::const_iterator search_it(line.cbegin());
-            if (std::regex_search(search_it, line.cend(), match, pattern) && match.size() >= 4) { 
-                std::string valve_name = match[1].str(); 
-                unsigned int flow_rate = std::stoi(match[2].str()); 
-                
-                // Check if there are one or more valves the current valve is leading to 
-                size_t start=0; 
-                while (true) {
-                    auto found_comma = match[3].str().find(',', start); 
-                    if (found_comma != std::string::npos) {
-                        neighboring_valves.insert(match[3].str().substr(start, found_comma-start)); 
-                        start = found_comma + 2; // skips also the space 
-                    } else {
-                        neighboring_valves.insert(match[3].str().substr(start)); 
-                        break; 
-                    }
-                }
-                Valve valve(valve_name, flow_rate, neighboring_valves); 
-                valves.insert(std::make_pair(valve_name, valve)); 
-            }
+        std::unordered_map<std::string_view, size_t> valve_ids; 
+        std::vector<size_t> input_order; 
+        auto intern = [&](std::string_view name) {
+            auto found = valve_ids.emplace(name, valves.size()); 
+            if (found.second) valves.emplace_back(name); 
+            return found.first->second; 
+        }; 
+
+        for (auto line: input_file.lines()) {
+            size_t valve_id = valves.size() + 1;  // not yet known 
+            unsigned int flow_rate = 0; 
+            std::vector<size_t> neighbors; 
+            aoc::scan_line<unsigned int>(line, [&](unsigned int n) { flow_rate = n; }, [&](std::string_view name) {
+                if (valve_id > valves.size()) valve_id = intern(name); 
+                else neighbors.push_back(intern(name)); 
+            }); 
+            if (valve_id > valves.size()) continue; 
+            valves[valve_id].flow_rate = flow_rate; 
+            valves[valve_id].neighbors = std::move(neighbors); 
+            input_order.push_back(valve_id); 
         }
+
+        // Renumber the valves in the order of the input 
+        std::vector<size_t> new_ids(valves.size(), valves.size()); 
+        size_t next_id = 0; 
+        for (auto id: input_order) new_ids[id] = next_id++; 
+        for (auto& id: new_ids) if (id == valves.size()) id = next_id++; 
+        Valves renumbered(valves.size(), Valve("")); 
+        for (size_t id = 0; id < valves.size(); ++id) {
+            for (auto& n: valves[id].neighbors) n = new_ids[n]; 
+            renumbered[new_ids[id]] = std::move(valves[id]); 
+        }
+        valves = std::move(renumbered); 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
-// This function will be used as a comparison function for the priority queue of the shortest path algorithm
-struct ValvesDistanceComparator {
-    bool operator()(const std::pair<std::string, unsigned int>& v1, const std::pair<std::string, unsigned int>& v2) const {
-        return v1.second <= v2.second; 
-    }
-};
-
-// Dijkstra algorithm: using a priority queue, it finds the shortest distance in the graph 
-// between the source and the destination valve. This is useful because it will allow us to 
-// maximize the amount of valves we can visit within the 30 minutes 
-auto shortest_path(const Valve& source, const Valve&  destination, ValvesMap& valves) {
-
-    std::set<std::pair<std::string, unsigned int>, ValvesDistanceComparator> priority_queue; 
-    // std::string prev{""}; 
-
-    std::unordered_set<std::string> visited_valves;
-    visited_valves.insert(source.name);  
-    priority_queue.insert(std::make_pair(source.name, 0)); 
-
-    while (!priority_queue.empty()) {
-        auto current_node_it = priority_queue.begin(); 
-        if (current_node_it->first == destination.name) return current_node_it->second; 
-
-        std::pair<std::string,int> current_node = {current_node_it->first, current_node_it->second};
-        priority_queue.erase(current_node_it); 
-        auto valve_it = valves.find(current_node.first); 
-        auto neighbors = valve_it->second.neighbors; 
-        
-        for (const auto& neighbor_node: neighbors) {
-            if (visited_valves.insert(neighbor_node).second) {
-                auto it = std::find_if(priority_queue.begin(), priority_queue.end(), [&neighbor_node](auto& v1){
-                    return v1.first == neighbor_node;
-                });
-                unsigned int dist = current_node.second + 1;
-                if (it != priority_queue.end()) {
-                    priority_queue.erase(it); 
-                }
-                auto is_inserted = priority_queue.insert(std::make_pair(neighbor_node, dist)); 
-            }
+// Breadth-First-Search: the distances (in minutes) from a valve to all the others, as every tunnel takes one minute 
+auto distances_from(const Valves& valves, size_t source) {
+    std::vector<unsigned int> distances(valves.size(), std::numeric_limits<unsigned int>::max()); 
+    std::vector<size_t> queue{source}; 
+    distances[source] = 0; 
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto v = queue[head]; 
+        for (auto n: valves[v].neighbors) {
+            if (distances[n] != std::numeric_limits<unsigned int>::max()) continue; 
+            distances[n] = distances[v] + 1; 
+            queue.push_back(n); 
         }
     }
-    return std::numeric_limits<unsigned int>::max(); 
+    return distances; 
 }
 
-// Calculates the shortest distance between all valves in the volcano. It returns such distances in terms of 
-// a std::unordered_map
-auto calculate_valve_distances(ValvesMap& valves) {
-
-    std::unordered_map<std::string, unsigned int> valves_distances;
-    auto valves_it = valves.cbegin(); 
-
-    while (valves_it != valves.cend()) {
-        auto valves_it_second = valves.cbegin(); 
-        if (valves_it->second.flow_rate == 0 && valves_it->first != "AA") {++valves_it; continue;} 
-        while (valves_it_second != valves.cend()) {
-            if (valves_it_second->second.flow_rate == 0) {++valves_it_second; continue;} 
-            std::string from_to = valves_it->first + '-' + valves_it_second->first;
-            std::string to_from = valves_it_second->first + '-' + valves_it->first; 
-            if (valves_distances.find(from_to) == valves_distances.end()) {
-                if (valves_it->first != valves_it_second->first) {
-                    auto dist = shortest_path(valves_it->second, valves_it_second->second, valves);
-                    valves_distances[from_to] = dist; 
-                    dist = shortest_path(valves_it_second->second, valves_it->second, valves);
-                    valves_distances[to_from] = dist; 
-                } else {
-                    valves_distances[from_to] = 0; 
-                    valves_distances[to_from] = 0; 
-                }
-            }
-            ++valves_it_second; 
+// Builds the network of the valves with a flow (plus the starting valve AA), with the dense matrix of the distances 
+// between them 
+auto build_network(const Valves& valves) {
+    ValveNetwork network; 
+    auto start = std::find_if(valves.begin(), valves.end(), [](const Valve& v) { return v.name == "AA"; }); 
+    if (start == valves.end()) throw std::runtime_error("The starting valve AA is missing"); 
+    auto start_id = static_cast<size_t>(start - valves.begin()); 
+
+    // The valves with a flow which cannot be reached from AA are left out 
+    auto distances_from_start = distances_from(valves, start_id); 
+    std::vector<size_t> key_valves; 
+    for (size_t v = 0; v < valves.size(); ++v) {
+        if (valves[v].flow_rate > 0 && distances_from_start[v] != std::numeric_limits<unsigned int>::max()) {
+            key_valves.push_back(v); 
+            network.flow_rates.push_back(valves[v].flow_rate); 
         }
-        ++valves_it; 
     }
-
-    // for (const auto it: valves_distances) {
-    //     std::cout << "distance " << it.first << " is " << it.second << std::endl; 
-    // }
-
-    return valves_distances; 
-}
-
-// Input of the simulation function. This is used here because it allows me to write the input in a compact way, 
-// besides allowing for easy caching of the intermediate results to speed up the algorithm.. 
-struct CurrentState {
-    std::string valve_from; 
-    std::unordered_set<std::string> opened_valves; 
-    unsigned int elapsed_time; 
-    unsigned int pressure_relieved; 
-
-    CurrentState(std::string vn, unsigned int et, unsigned int tpr): valve_from(vn), elapsed_time(et), pressure_relieved(tpr) {} 
-    CurrentState(): valve_from("AA"), elapsed_time(0), pressure_relieved(0) {} // {path.push_back("AA");}
-
-    auto opened_to_string() const {
-        std::string opened_valves_string; 
-        auto it = opened_valves.begin();  
-        while (it!= opened_valves.end()) {
-            opened_valves_string += *it;
-            opened_valves_string += "-"; 
-            ++it; 
-        }
-        return opened_valves_string; 
+    network.n_flowing = key_valves.size(); 
+    if (network.n_flowing > MAX_FLOWING_VALVES) {
+        throw std::runtime_error("Too many valves with a flow: " + std::to_string(network.n_flowing)); 
     }
+    key_valves.push_back(start_id); 
 
-    auto to_string() const {
-        std::string state_string = valve_from + '-' + std::to_string(elapsed_time) + '-' + std::to_string(pressure_relieved) + '-'; 
-        state_string += this->opened_to_string(); 
-        return state_string; 
+    auto n_key_valves = key_valves.size(); 
+    network.distances.resize(n_key_valves * n_key_valves); 
+    for (size_t i = 0; i < n_key_valves; ++i) {
+        auto distances = distances_from(valves, key_valves[i]); 
+        for (size_t j = 0; j < n_key_valves; ++j) network.distances[i * n_key_valves + j] = distances[key_valves[j]]; 
     }
+    return network; 
+}
 
+// Opening the valves of a set R in some order relieves, by max_time, 
+//     sum over v in R of flow(v) * (max_time - t(v)) = max_time * flow(R) - sum over v in R of flow(v) * t(v) 
+// where t(v) is the minute at which v is opened. The second sum (the pressure lost) can be counted leg by leg: every 
+// minute spent walking to the next valve and opening it is lost for all the valves of R which are still closed. So the 
+// cheapest order to open all the valves of R starting from the valve p is 
+//     cost(R, p) = min over v in R of (distance(p, v) + 1) * flow(R) + cost(R - v, v) 
+// which does not depend on max_time. The orders which end after max_time count their late valves negatively: such an 
+// order is never better than the same order without its late valves (a subset of R, whose other valves are opened no 
+// later), so the best pressure over all the subsets of a set, which is all that both parts need, is unchanged. 
+// The costs saturate at NO_ORDER (e.g. when a valve cannot be reached), which never gives a positive pressure 
+constexpr uint64_t NO_ORDER = std::numeric_limits<uint32_t>::max(); 
+
+struct OpeningCosts {
+    size_t n_flowing = 0; 
+    std::vector<uint32_t> set_flows;  // flow(R) of every set R 
+    std::vector<uint32_t> costs;      // cost(R, p), at R * n_flowing + p (only meaningful for p not in R) 
 }; 
 
-// The simulation function. It recursively calls itself as follows: 
-// first, it checks if given the curent state, the 30 (or 26) minutes have passed, or if all the valves having flow != 0 are opened
-// If that's the case, it calcualtes how many minutes we still have left, and calculates the pressure to relieve until we reach max_time
-// Second, it loops through the unopened valves, updates the current total pressure, how many new minutes have elapsed (given by 
-// the distance from the source to the destination valve), and updates the new set of open valves 
-// Last, it recursively calls itself to calculate the new updated pressure. It returns the maximizing pressure 
-// For Part 2, the ele_cache (pointer) map keeps track of the sets of open valves and the corresponding maximized pressure. 
-// For Part 1, this element defaults to a null pointer. 
-auto find_max_relief(CurrentState current_state, const ValvesMap& valves, 
-                     std::unordered_set<std::string>& flowing_valves,
-                     std::unordered_map<std::string, unsigned int>& valves_distances, 
-                     std::unordered_map<std::string, unsigned int>& cache, unsigned int max_time = 30, 
-                     std::unordered_map<std::unordered_set<std::string>, unsigned int, HashSetHash, HashSetEqual>* ele_cache=nullptr) -> unsigned int {
-
-    auto css = current_state.to_string(); 
-    if (cache.find(css) != cache.end()) return cache.find(css)->second;  
-
-    unsigned int current_total_pressure_relieved = 0; 
-    for (const auto& v: current_state.opened_valves) current_total_pressure_relieved += valves.find(v)->second.flow_rate; 
-
-    // Check if the elapsed time is over, the number of opened valves is to the max, or if we need to cache the results for part 2
-    if ((current_state.elapsed_time >= max_time || current_state.opened_valves.size() == flowing_valves.size()) || (ele_cache)) {
-        auto pressure_per_minute = current_total_pressure_relieved; 
-        auto total_pressure = current_state.pressure_relieved + (pressure_per_minute * (max_time - current_state.elapsed_time));
-        cache[current_state.to_string()] = total_pressure;  
-
-        if (ele_cache) {
-            if (!ele_cache->insert(std::make_pair(current_state.opened_valves, total_pressure)).second) {
-                if (total_pressure > (*ele_cache)[current_state.opened_valves]) (*ele_cache)[current_state.opened_valves] = total_pressure; 
-            }  
+// The minutes to walk from every valve (the flowing ones, then AA) to the flowing valve v and open it, stored by v 
+auto steps_to_valves(const ValveNetwork& network) {
+    std::vector<uint64_t> steps((network.n_flowing + 1) * network.n_flowing); 
+    for (size_t v = 0; v < network.n_flowing; ++v) {
+        for (size_t from = 0; from <= network.n_flowing; ++from) {
+            auto distance = network.distance(from, v); 
+            steps[v * (network.n_flowing + 1) + from] = distance == std::numeric_limits<unsigned int>::max() ? NO_ORDER : distance + 1; 
         }
-        else return total_pressure; // In part two, returning here would mean to stop the algorithm at the first iteration, we just let it go 
     }
-    
-    // This is another potential solution but I need to work on that as it leads to the wrong result as is 
-    // auto max_pressure = !ele_cache ? 0 : find_max_relief(CurrentState(), valves, flowing_valves, valves_distances, cache, max_time);    
-    auto max_pressure = 0; 
-
-    // Find the unopened valves and loop through them 
-    std::unordered_set<std::string> unopened_valves; 
-    for (auto& fw: flowing_valves) if (current_state.opened_valves.find(fw) == current_state.opened_valves.end()) unopened_valves.insert(fw); 
-
-    for (const auto& next_valve: unopened_valves) {
-        // Update the distance, elapsed time, and pressure relieved for each valve we need to visit
-        auto dist = valves_distances[current_state.valve_from + '-' + next_valve] + 1; // +1 because we're opening the valve
-        auto new_elapsed_time = current_state.elapsed_time + dist;   
-        auto new_pressure_relieved = current_total_pressure_relieved *  dist;  
-        new_pressure_relieved += current_state.pressure_relieved; 
-        
-        // Check if the elaped time is over: if so simply check if the max pressure needs to be updated 
-        if (new_elapsed_time >= max_time) {
-            auto pressure_per_minute = current_total_pressure_relieved; 
-            auto total_pressure = current_state.pressure_relieved + (pressure_per_minute * (max_time - current_state.elapsed_time));
-            if (total_pressure > max_pressure) max_pressure = total_pressure; 
-            continue;   
-        }
+    return steps; 
+}
 
-        // Recursively call the function with the new updated state 
-        CurrentState new_state{next_valve, new_elapsed_time, new_pressure_relieved}; 
-        new_state.opened_valves = current_state.opened_valves;
-        new_state.opened_valves.insert(next_valve);  // updates the opened valves set 
-        auto new_pressure = find_max_relief(new_state, valves, flowing_valves, valves_distances, cache, max_time, ele_cache); 
-        // Check if the pressure has a new maximum and cache the result for fast retrieval  
-        if (new_pressure > max_pressure) max_pressure = new_pressure; 
-        cache[new_state.to_string()] = max_pressure;
+// Approach: fill the table of cost(R, p) in increasing order of R, as R - v is always smaller than R. For each v in R, 
+// cost(R - v, v) is the same for every starting valve p, so the valves p are updated together in a simple loop 
+auto find_opening_costs(const ValveNetwork& network) {
+    const auto n_flowing = network.n_flowing; 
+    const size_t n_sets = size_t{1} << n_flowing; 
+    const auto steps = steps_to_valves(network); 
+    OpeningCosts costs; 
+    costs.n_flowing = n_flowing; 
+    costs.set_flows.assign(n_sets, 0); 
+    costs.costs.assign(n_sets * n_flowing, 0); 
+
+    for (size_t set = 1; set < n_sets; ++set) {
+        const uint64_t set_flow = costs.set_flows[set] = costs.set_flows[set & (set - 1)] + network.flow_rates[__builtin_ctzll(set)]; 
+        auto* set_costs = costs.costs.data() + set * n_flowing; 
+        std::fill(set_costs, set_costs + n_flowing, static_cast<uint32_t>(NO_ORDER)); 
+        for (auto rest = set; rest != 0; rest &= rest - 1) {
+            auto v = static_cast<size_t>(__builtin_ctzll(rest)); 
+            const uint64_t rest_cost = costs.costs[(set ^ (size_t{1} << v)) * n_flowing + v]; 
+            const auto* steps_to_v = steps.data() + v * (n_flowing + 1); 
+            for (size_t from = 0; from < n_flowing; ++from) {
+                set_costs[from] = static_cast<uint32_t>(std::min<uint64_t>(set_costs[from], std::min(steps_to_v[from] * set_flow + rest_cost, NO_ORDER))); 
+            }
+        }
     }
-
-    return max_pressure; 
+    return costs; 
 }
 
-
-// This solution (for Part 1) is equivalent; in my opinion, a bit more intuitive but also a bit slower. 
-// At each recursive call, it keeps track of how much new steam has been released by the new valve, 
-// rather than keeping track of the total amount of steam released at each step by all valves. 
-// auto find_max_relief(CurrentState current_state, const ValvesMap& valves, 
-//                         std::unordered_set<std::string>& flowing_valves,
-//                         std::unordered_map<std::string, unsigned int>& valves_distances, 
-//                         std::unordered_map<std::string, unsigned int>& cache, unsigned int max_time = 30) -> unsigned int {
-
-//     auto css = current_state.to_string(); 
-//     if (cache.find(css) != cache.end()) return cache.find(css)->second;  
-
-//     if (current_state.elapsed_time > max_time || current_state.opened_valves.size() == flowing_valves.size()) {
-//         auto css = current_state.to_string(); 
-//         cache[css] = 0;
-//         return 0;  
-//     }
-
-//     unsigned int max_pressure = 0; 
-//     unsigned int new_pressure = 0; 
-//     auto new_opened = current_state.opened_valves; 
-//     auto new_elapsed_time = current_state.elapsed_time + 1; 
-
-//     std::unordered_set<std::string> unopened_valves; 
-//     for (auto& fw: flowing_valves) if (current_state.opened_valves.find(fw) == current_state.opened_valves.end()) unopened_valves.insert(fw); 
-    
-//     if (unopened_valves.find(current_state.valve_from) != unopened_valves.end()) {
-//         new_pressure = valves.find(current_state.valve_from)->second.flow_rate * (max_time - new_elapsed_time); 
-//         new_opened.insert(current_state.valve_from); 
-//     }
-
-//     for (const auto& next_valve: flowing_valves) {
-//         if (next_valve == current_state.valve_from) continue; 
-//         auto dist = valves_distances[current_state.valve_from + '-' + next_valve]; 
-
-//         CurrentState new_state{next_valve, new_elapsed_time + dist - (new_pressure == 0), new_pressure}; 
-//         new_state.opened_valves = new_opened; 
-
-//         auto path_pressure = find_max_relief(new_state, valves, flowing_valves, valves_distances, cache);  
-//         cache[new_state.to_string()] = path_pressure;  
-//         if ((new_pressure + path_pressure) > max_pressure) max_pressure = (new_pressure + path_pressure); 
-//     }
-
-//     return max_pressure; 
-// }
-
-// Part one: creates the inputs and run the simulation; returns the result
-auto run_part_one(ValvesMap& valves) {
-    auto valves_distances = calculate_valve_distances(valves); 
-    auto number_of_zero_flow_valves = 0; 
-    std::unordered_map<std::string, unsigned int> cache; 
-    CurrentState initial_state; 
-    std::unordered_set<std::string> flowing_valves;
-    for (auto& fw: valves) if (fw.second.flow_rate != 0) flowing_valves.insert(fw.first); 
-    auto max_relief = find_max_relief(initial_state, valves, flowing_valves, valves_distances, cache);
-    return max_relief;    
+// The best pressure relieved within max_time minutes for each set (bitmask) of opened valves, starting from AA 
+auto find_best_by_opened(const ValveNetwork& network, const OpeningCosts& costs, unsigned int max_time) {
+    const auto n_flowing = network.n_flowing; 
+    const auto steps = steps_to_valves(network); 
+    std::vector<unsigned int> best_by_opened(costs.set_flows.size(), 0); 
+    for (size_t set = 1; set < best_by_opened.size(); ++set) {
+        uint64_t cost = NO_ORDER; 
+        for (auto rest = set; rest != 0; rest &= rest - 1) {
+            auto v = static_cast<size_t>(__builtin_ctzll(rest)); 
+            uint64_t rest_cost = costs.costs[(set ^ (size_t{1} << v)) * n_flowing + v]; 
+            cost = std::min(cost, steps[v * (n_flowing + 1) + network.start()] * costs.set_flows[set] + rest_cost); 
+        }
+        int64_t pressure = int64_t{max_time} * costs.set_flows[set] - static_cast<int64_t>(cost); 
+        best_by_opened[set] = static_cast<unsigned int>(std::max<int64_t>(pressure, 0)); 
+    }
+    return best_by_opened; 
 }
 
+// Part one: the best pressure over all the sets of opened valves 
+auto run_part_one(const Valves& valves) {
+    auto network = build_network(valves); 
+    auto best_by_opened = find_best_by_opened(network, find_opening_costs(network), 30); 
+    return *std::max_element(best_by_opened.begin(), best_by_opened.end()); 
+}
 
-void solve_part_one(ValvesMap& valves) {
-    // auto solution = find_max_relief(valves); 
+void solve_part_one(const Valves& valves) {
     auto solution = run_part_one(valves); 
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
-// Part two: creates the inputs and run the simulation; we use the ele_cache object to find the solution
-// In particular we need to find the two disjoint sets of opened valves that maximize the relieved pressure 
-// This is because the elefan and the human cannot open the same valve twice 
-auto run_part_two(ValvesMap& valves) {
-    auto valves_distances = calculate_valve_distances(valves); 
-    auto number_of_zero_flow_valves = 0; 
-    std::unordered_map<std::string, unsigned int> cache; 
-    CurrentState initial_state; 
-    std::unordered_set<std::string> flowing_valves;
-    for (auto& fw: valves) if (fw.second.flow_rate != 0) flowing_valves.insert(fw.first); 
-    std::unordered_map<std::unordered_set<std::string>, unsigned int, HashSetHash, HashSetEqual> ele_cache; 
-    find_max_relief(initial_state, valves, flowing_valves, valves_distances, cache, 26, &ele_cache); 
-
-    auto outer_it = ele_cache.begin(); 
-    auto max_pressure = 0; 
-    while(outer_it != ele_cache.end()) {
-        if (outer_it == ele_cache.end()) break; 
-        auto inner_it = std::next(outer_it); 
-        while (inner_it != ele_cache.end()) {
-            if (outer_it->first == inner_it->first) {++inner_it; continue;}
-
-            // Check if the two sets are disjoint (they shouldn't have elements in common as the human
-            // and the elephant should maximize two different paths)
-            bool disjoint = true; 
-            for (const auto& outer_elements: outer_it->first) {
-                if (inner_it->first.find(outer_elements) != inner_it->first.end()) {
-                    disjoint = false; break; 
-                }
-            }
-            if (!disjoint) {++inner_it; continue;}
-            auto tmp_pressure = outer_it->second + inner_it->second; 
-            if (tmp_pressure > max_pressure) max_pressure = tmp_pressure; 
-            ++inner_it; 
+// Sum-over-subsets max transform: afterwards, the entry of a bitmask is the best pressure over all its subsets. The 
+// bits are added one at a time, so every subset is reached from the mask through its missing bits 
+void propagate_to_supersets(std::vector<unsigned int>& best_by_opened) {
+    for (size_t bit = 1; bit < best_by_opened.size(); bit <<= 1) {
+        for (size_t opened = 0; opened < best_by_opened.size(); ++opened) {
+            if (opened & bit) best_by_opened[opened] = std::max(best_by_opened[opened], best_by_opened[opened ^ bit]); 
         }
-        ++outer_it; 
+    }
+}
+
+// Part two: we need to find the two disjoint sets of opened valves that maximize the relieved pressure within 26 minutes
+// This is because the elefan and the human cannot open the same valve twice. Once the best pressure of every set is 
+// propagated to its supersets, the best partner of a set is simply the entry of its complement 
+auto run_part_two(const Valves& valves) {
+    auto network = build_network(valves); 
+    auto best_by_opened = find_best_by_opened(network, find_opening_costs(network), 26); 
+    auto best_subset = best_by_opened; 
+    propagate_to_supersets(best_subset); 
+
+    const size_t all_valves = best_by_opened.size() - 1; 
+    unsigned int max_pressure = 0; 
+    for (size_t opened = 0; opened < best_by_opened.size(); ++opened) {
+        max_pressure = std::max(max_pressure, best_by_opened[opened] + best_subset[all_valves & ~opened]); 
     }
     return max_pressure; 
 }
 
-void solve_part_two(ValvesMap& valves) {
+void solve_part_two(const Valves& valves) {
     auto solution = run_part_two(valves);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day16
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day16::day, argc, argv); 
+}
+#endif
@@ -1,7 +1,6 @@
 #include <iostream> 
 #include <string>
 #include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <algorithm>
 #include <regex>  
@@ -11,6 +10,11 @@
 #include <utility> 
 #include <set> 
 
+#include "day.h"
+#include "input.h"
+
+namespace day17 {
+
 // For part 1, I will simulate the rocks dropping, one by one. The air jets will define horizontal directions, 
 // followed by a downwards one (for each rock we just need to start from the highest current level + 1). 
 // For part 2, we need to identify a circular cycle in order to speed up the computations. This is done by caching 
@@ -78,45 +82,34 @@ void get_data(const std::string&, std::string&);
 void solve_part_one(const std::string&); 
 void solve_part_two(const std::string&); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 17 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test; 
-    std::string jets; 
-
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::string jets; 
 
+void load(const std::string& file_name, bool) {
+    jets.clear(); 
     get_data(file_name, jets); 
+}
 
-    if (is_test) {
-        std::cout << jets << std::endl; 
-    }
+void print() {
+    aoc::out() << jets << std::endl; 
+}
 
-    solve_part_one(jets); 
-    solve_part_two(jets); 
+void part_one() { solve_part_one(jets); }
+void part_two() { solve_part_two(jets); }
 
-    return 0; 
-}
+extern const aoc::Day day{17, load, print, part_one, part_two}; 
 
 // Get the data, using regex 
 void get_data(const std::string& file_name, std::string& jets) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
+        for (auto line: input_file.lines()) {
             jets += line; 
         }
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -169,7 +162,7 @@ auto drop_rocks(const std::string& jets) {
 
 void solve_part_one(const std::string& jets) {
     auto solution = drop_rocks(jets);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
 // The algorithm works as in part one, except that we keep track in a cache of the following combinations: 
@@ -244,7 +237,13 @@ auto drop_rocks_with_cycles(const std::string& jets, size_t n_rocks) {
 
 void solve_part_two(const std::string& jets) {
     auto solution = drop_rocks_with_cycles(jets, 1000000000000);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day17
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day17::day, argc, argv); 
+}
+#endif
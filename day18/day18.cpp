@@ -1,11 +1,14 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <unordered_set> 
 #include <queue>
 
+#include "day.h"
+#include "input.h"
+
+namespace day18 {
+
 // For Day 18, I create a Cube struct which contains the coordinates x, y, z. To solve part I's puzzle, I put all the 
 // input cubes inside a hash set, and check for each cube's face whether there are cubes adjacent to it. If so, then the 
 // surface is excluded from the grand total. For Part II, I calculate a sort of "min" and "max" cubes, which contains the 
@@ -35,7 +38,7 @@ struct Cube {
     }
 
     void print() const {
-        std::cout << "(" << x << "," << y << "," << z << ")" << std::endl; 
+        aoc::out() << "(" << x << "," << y << "," << z << ")" << std::endl; 
     }
 };
 
@@ -44,45 +47,33 @@ void get_data(const std::string&, std::unordered_set<Cube, Cube::CubeHash>&);
 void solve_part_one(const std::unordered_set<Cube, Cube::CubeHash>&); 
 void solve_part_two(const std::unordered_set<Cube, Cube::CubeHash>&); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 18 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test; 
-    std::unordered_set<Cube, Cube::CubeHash> cubes; 
-
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::unordered_set<Cube, Cube::CubeHash> cubes; 
 
+void load(const std::string& file_name, bool) {
+    cubes.clear(); 
     get_data(file_name, cubes); 
+}
 
-    if (is_test) {
-        for (const auto& c: cubes) c.print(); 
-    }
+void print() {
+    for (const auto& c: cubes) c.print(); 
+}
 
-    solve_part_one(cubes); 
-    solve_part_two(cubes); 
+void part_one() { solve_part_one(cubes); }
+void part_two() { solve_part_two(cubes); }
 
-    return 0; 
-}
+extern const aoc::Day day{18, load, print, part_one, part_two}; 
 
 // Get the input data
 void get_data(const std::string& file_name,std::unordered_set<Cube, Cube::CubeHash>& cubes) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            std::istringstream line_stream(line); 
+        for (auto line: input_file.lines()) {
+            // Each line is "x,y,z"
             int x, y, z; 
-            line_stream >> x; 
-            line_stream.ignore(); 
-            line_stream >> y; 
-            line_stream.ignore(); 
-            line_stream >> z; 
+            if (!aoc::next_int(line, x)) continue; 
+            aoc::next_int(line, y); 
+            aoc::next_int(line, z); 
             Cube cube(x, y, z); 
             cubes.insert(cube); 
         }
@@ -90,10 +81,8 @@ void get_data(const std::string& file_name,std::unordered_set<Cube, Cube::CubeHa
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
-// Algorithms 
 auto count_disconnected_surfaces(const std::unordered_set<Cube, Cube::CubeHash>& cubes) {
 
     long int n_disconnected_surfaces = 0; 
@@ -132,7 +121,7 @@ auto count_disconnected_surfaces(const std::unordered_set<Cube, Cube::CubeHash>&
 
 void solve_part_one(const std::unordered_set<Cube, Cube::CubeHash>& cubes) {
     auto solution = count_disconnected_surfaces(cubes);
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 auto count_surfaces_exposed_cubes(const std::unordered_set<Cube, Cube::CubeHash>& cubes) {
@@ -210,7 +199,13 @@ auto count_surfaces_exposed_cubes(const std::unordered_set<Cube, Cube::CubeHash>
 
 void solve_part_two(const std::unordered_set<Cube, Cube::CubeHash>& cubes) {
     auto solution = count_surfaces_exposed_cubes(cubes);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day18
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day18::day, argc, argv); 
+}
+#endif
@@ -1,14 +1,18 @@
 #include <iostream> 
 #include <string>
 #include <sstream>
-#include <fstream> 
 #include <vector> 
-#include <regex> 
+#include <array> 
 #include <unordered_map> 
 #include <queue>
 #include <cmath> 
 #include <algorithm> 
 
+#include "day.h"
+#include "input.h"
+
+namespace day19 {
+
 // To solve this day's puzzle, I will use a Depth First Search algorithm, as we want to find the max possible 
 // amount of goede among all possible combinations of robots to build and minerals to be picked. In order to 
 // obtain a computationally feasible algorithm some optimizations can be applied which take advantage of many 
@@ -73,7 +77,7 @@ struct Blueprint {
         for (const auto& c: max_cost) prt_str += std::to_string(c) + " "; 
         prt_str += ")\n"; 
 
-        std::cout << prt_str << std::endl; 
+        aoc::out() << prt_str << std::endl; 
     }
 
     // This is useful for creating string keys for hash sets 
@@ -91,58 +95,40 @@ void get_data(const std::string&, std::vector<Blueprint>&);
 void solve_part_one(const std::vector<Blueprint>&); 
 void solve_part_two(const std::vector<Blueprint>&); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 19 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test; 
-    std::vector<Blueprint> blueprints; 
-
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::vector<Blueprint> blueprints; 
 
+void load(const std::string& file_name, bool) {
+    blueprints.clear(); 
     get_data(file_name, blueprints); 
+}
 
-    if (is_test) {
-        for (const auto& b: blueprints) b.print(); 
-    }
+void print() {
+    for (const auto& b: blueprints) b.print(); 
+}
 
-    solve_part_one(blueprints); 
-    solve_part_two(blueprints); 
+void part_one() { solve_part_one(blueprints); }
+void part_two() { solve_part_two(blueprints); }
 
-    return 0; 
-}
+extern const aoc::Day day{19, load, print, part_one, part_two}; 
 
 // Get the input data
 void get_data(const std::string& file_name, std::vector<Blueprint>& blueprints) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-
-             
-
-            std::vector<std::smatch> matches; 
-            // std::regex pattern("\\b(\\d+)\\s*(\\w+)\\b"); 
-            std::regex pattern("\\b(\\d+)\\b"); 
-            auto begin = std::sregex_iterator(line.begin(), line.end(), pattern); 
-            auto end = std::sregex_iterator(); // regex iterator to find all the numbers in the line 
+        // Each line holds seven numbers: the blueprint number, and then the costs of the robots 
+        std::array<long int, 7> numbers; 
+        for (auto line: input_file.lines()) {
+            if (aoc::scan_ints<long int>(line, numbers) < numbers.size()) continue; 
 
-            for (auto it = begin; it != end; ++it) {
-                matches.push_back(*it); 
-            }
-            
-            size_t blueprint_number = std::stoul(matches[0][1].str()); 
+            size_t blueprint_number = static_cast<size_t>(numbers[0]); 
             Blueprint blueprint(blueprint_number);
-            long int ore_cost_ore = std::stol(matches[1][1].str()); 
-            long int clay_cost_ore = std::stol(matches[2][1].str()); 
-            long int obsidian_cost_ore = std::stol(matches[3][1].str()); 
-            long int obsidian_cost_clay = std::stol(matches[4][1].str()); 
-            long int goede_cost_ore = std::stol(matches[5][1].str()); 
-            long int goede_cost_obsidian = std::stol(matches[6][1].str()); 
+            long int ore_cost_ore = numbers[1]; 
+            long int clay_cost_ore = numbers[2]; 
+            long int obsidian_cost_ore = numbers[3]; 
+            long int obsidian_cost_clay = numbers[4]; 
+            long int goede_cost_ore = numbers[5]; 
+            long int goede_cost_obsidian = numbers[6]; 
             auto max_ore = std::max({ore_cost_ore, clay_cost_ore, obsidian_cost_ore, goede_cost_ore}); 
             auto max_clay = obsidian_cost_clay; 
             auto max_obsidian = goede_cost_obsidian; 
@@ -158,15 +144,11 @@ void get_data(const std::string& file_name, std::vector<Blueprint>& blueprints)
             blueprint.max_cost.at(2) = max_obsidian; 
 
             blueprints.push_back(blueprint); 
-            // for (const auto& match: matches) {
-                // std::cout << "Number: " << match[1].str() << " Term : " << match[2].str() << std::endl; 
-            // }
         }
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -274,7 +256,7 @@ auto calculate_quality_level(const std::vector<Blueprint>& blueprints) {
 
 void solve_part_one(const std::vector<Blueprint>& blueprints) {
     auto solution = calculate_quality_level(blueprints);
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 auto calculate_quality_level_part_two(const std::vector<Blueprint>& blueprints) {
@@ -289,7 +271,13 @@ auto calculate_quality_level_part_two(const std::vector<Blueprint>& blueprints)
 
 void solve_part_two(const std::vector<Blueprint>& blueprints) {
     auto solution = calculate_quality_level_part_two(blueprints);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day19
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day19::day, argc, argv); 
+}
+#endif
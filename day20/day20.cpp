@@ -1,9 +1,12 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 
+#include "day.h"
+#include "input.h"
+
+namespace day20 {
+
 // To solve this level I will store the numbers as Nodes of a doubly linked list. A vector of such nodes will be useful 
 // to preserve the original order of the numbers, and to create the right original references between previous and next
 // pointers to the current node. When the list of numbers is mixed, then the pointers are updated accordingly. The 
@@ -34,56 +37,49 @@ void get_data(const std::string&, std::vector<Node>&);
 void solve_part_one(std::vector<Node>&); 
 void solve_part_two(std::vector<Node>&); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 20 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test = false; 
-    std::vector<Node> list; 
-    
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::vector<Node> list; 
 
+void load(const std::string& file_name, bool) {
+    list.clear(); 
     get_data(file_name, list); 
+}
 
-    if (is_test) { 
-        Node node = list.at(0); 
-        size_t i = 0; 
-        while (i < list.size()) {
-            std::cout << node.val; 
-            if (i < list.size() - 1) std::cout << " -> "; 
-            else std::cout << std::endl; 
-            node = *node.next;   
-            // node = *node.prev;   
-            ++i; 
-        }
+void print() {
+    Node node = list.at(0); 
+    size_t i = 0; 
+    while (i < list.size()) {
+        aoc::out() << node.val; 
+        if (i < list.size() - 1) aoc::out() << " -> "; 
+        else aoc::out() << std::endl; 
+        node = *node.next;   
+        // node = *node.prev;   
+        ++i; 
     }
+}
+
+void part_one() { solve_part_one(list); }
 
-    solve_part_one(list); 
+void part_two() { 
     set_vector_pointers(list); // For part two we need to reset the list (as we are changing the list references)
     solve_part_two(list); 
-
-    return 0; 
 }
 
+extern const aoc::Day day{20, load, print, part_one, part_two}; 
+
 // Get the input data
 void get_data(const std::string& file_name, std::vector<Node>& list) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            long int new_val = std::stol(line); 
-            list.emplace_back(Node(new_val)); 
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            list.emplace_back(Node(aoc::to_int<long int>(line))); 
         }
         set_vector_pointers(list); 
     } else {
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -141,13 +137,13 @@ auto decrypt_list(std::vector<Node>& list, long int decryption_key = 1, size_t n
         // For debugging
         // size_t ii = 0; 
         // Node v = *starting_node; 
-        // std::cout << "round " << i << std::endl; 
+        // aoc::out() << "round " << i << std::endl; 
         // while (ii < list.size()) {
-        //     std::cout << v.val << " "; 
+        //     aoc::out() << v.val << " "; 
         //     v = *v.next; 
         //     ++ii; 
         // }
-        // std::cout << std::endl; 
+        // aoc::out() << std::endl; 
     }
 
     // Now count the final grove coordinate...
@@ -156,7 +152,7 @@ auto decrypt_list(std::vector<Node>& list, long int decryption_key = 1, size_t n
         for (size_t it2 = 0; it2 < 1000; ++it2) {
             starting_node = starting_node->next; 
         }
-        // std::cout << starting_node->val << std::endl; 
+        // aoc::out() << starting_node->val << std::endl; 
         grove_coordinate += starting_node->val; 
     }
     return grove_coordinate; 
@@ -165,12 +161,18 @@ auto decrypt_list(std::vector<Node>& list, long int decryption_key = 1, size_t n
 
 void solve_part_one(std::vector<Node>& list) {
     auto solution = decrypt_list(list);
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 void solve_part_two(std::vector<Node>& list) {
     auto solution = decrypt_list(list, 811589153, 10);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day20
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day20::day, argc, argv); 
+}
+#endif
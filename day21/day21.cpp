@@ -1,10 +1,13 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <unordered_map>
 
+#include "day.h"
+#include "input.h"
+
+namespace day21 {
+
 // To solve this day's puzzle, I will use a recursive methodology. I will try through recursive calls to the 
 // number calculating function to reconstruct the number that the root monkey is supposed to yell. To perform the 
 // operations, I will use a custom-defined function that takes the operation character ('-', '+', ...) as input, 
@@ -38,7 +41,7 @@ struct NumberMonkey {
     NumberMonkey() : n(0) {}
     NumberMonkey(long int n_) : n(n_) {}
 
-    auto print() const {std::cout << n << std::endl;}
+    auto print() const {aoc::out() << n << std::endl;}
 }; 
 
 // Monkey whose number needs to be calculated
@@ -49,7 +52,7 @@ struct OpMonkey {
     OpMonkey() : monkey_one(""), monkey_two(""), op(' ') {}
     OpMonkey(std::string m_one_, char op_, std::string m_two_): monkey_one(m_one_), op(op_), monkey_two(m_two_) {}
 
-    auto print() const {std::cout << monkey_one << op << monkey_two << std::endl;}
+    auto print() const {aoc::out() << monkey_one << op << monkey_two << std::endl;}
 }; 
 
 void get_data(const std::string&, std::unordered_map<std::string, NumberMonkey>&, std::unordered_map<std::string, OpMonkey>&);  
@@ -58,64 +61,50 @@ void solve_part_one(const std::unordered_map<std::string, NumberMonkey>& number_
 void solve_part_two(const std::unordered_map<std::string, NumberMonkey>& number_monkeys, 
                     const std::unordered_map<std::string, OpMonkey>& op_monkeys); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 21 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test = false; 
-    std::unordered_map<std::string, NumberMonkey> number_monkeys; 
-    std::unordered_map<std::string, OpMonkey> op_monkeys; 
-    
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+std::unordered_map<std::string, NumberMonkey> number_monkeys; 
+std::unordered_map<std::string, OpMonkey> op_monkeys; 
 
+void load(const std::string& file_name, bool) {
+    number_monkeys.clear(); 
+    op_monkeys.clear(); 
     get_data(file_name, number_monkeys, op_monkeys); 
+}
 
-    if (is_test) { 
-        for (const auto& item: number_monkeys) {
-            std::cout << item.first << ":\t";
-            item.second.print(); 
-        }
+void print() {
+    for (const auto& item: number_monkeys) {
+        aoc::out() << item.first << ":\t";
+        item.second.print(); 
+    }
 
-        for (const auto& item: op_monkeys) {
-            std::cout << item.first << ":\t";
-            item.second.print(); 
-        }
+    for (const auto& item: op_monkeys) {
+        aoc::out() << item.first << ":\t";
+        item.second.print(); 
     }
+}
 
-    solve_part_one(number_monkeys, op_monkeys); 
-    solve_part_two(number_monkeys, op_monkeys); 
+void part_one() { solve_part_one(number_monkeys, op_monkeys); }
+void part_two() { solve_part_two(number_monkeys, op_monkeys); }
 
-    return 0; 
-}
+extern const aoc::Day day{21, load, print, part_one, part_two}; 
 
 // Get the input data
 void get_data(const std::string& file_name, std::unordered_map<std::string, NumberMonkey>& number_monkeys, 
                 std::unordered_map<std::string, OpMonkey>& op_monkeys) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
-        while (std::getline(input_file, line)) {
-            std::istringstream line_stream(line); 
-            std::string monkey_name; 
-
-            std::getline(line_stream, monkey_name, ':'); 
-            line_stream.ignore(); // ignore the next white space              
-            std::string rest_of_line;
-            std::getline(line_stream, rest_of_line); 
-            if (std::isdigit(rest_of_line.at(0))) {
-                long int n = std::stol(rest_of_line); 
+        for (auto line: input_file.lines()) {
+            if (line.empty()) continue; 
+            // Each line is either "<name>: <number>" or "<name>: <monkey one> <op> <monkey two>"
+            std::string monkey_name(aoc::next_field(line, ':')); 
+            line.remove_prefix(1); // ignore the next white space              
+            if (std::isdigit(line.at(0))) {
+                long int n = aoc::to_int<long int>(line); 
                 number_monkeys.emplace(monkey_name, NumberMonkey(n)); 
             } else {
-                std::string monkey_one, monkey_two; 
-                char op; 
-                std::istringstream monkey_stream(rest_of_line); 
-                monkey_stream >> monkey_one; 
-                monkey_stream >> op; 
-                monkey_stream >>  monkey_two; 
+                std::string monkey_one(aoc::next_field(line)); 
+                char op = aoc::next_field(line).at(0); 
+                std::string monkey_two(aoc::next_field(line)); 
                 op_monkeys.emplace(monkey_name, OpMonkey(monkey_one, op, monkey_two)); 
             }
         }
@@ -123,7 +112,6 @@ void get_data(const std::string& file_name, std::unordered_map<std::string, Numb
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -148,7 +136,7 @@ auto calculate_monkey_number(const std::string monkey_name, const std::unordered
 void solve_part_one(const std::unordered_map<std::string, NumberMonkey>& number_monkeys, 
                     const std::unordered_map<std::string, OpMonkey>& op_monkeys) {
     auto solution = calculate_monkey_number("root", number_monkeys, op_monkeys);
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 // For part two: find out whether for a specific monkey's path depend on the humn or not (returns a boolean)
@@ -255,7 +243,13 @@ auto run_part_two(const std::unordered_map<std::string, NumberMonkey>& number_mo
 void solve_part_two(const std::unordered_map<std::string, NumberMonkey>& number_monkeys, 
                     const std::unordered_map<std::string, OpMonkey>& op_monkeys) {
     auto solution = run_part_two(number_monkeys, op_monkeys);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day21
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day21::day, argc, argv); 
+}
+#endif
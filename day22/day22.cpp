@@ -1,11 +1,14 @@
 #include <iostream> 
 #include <string>
-#include <sstream>
-#include <fstream> 
 #include <vector> 
 #include <unordered_map>
 #include <algorithm>
 
+#include "day.h"
+#include "input.h"
+
+namespace day22 {
+
 // The map will be stored in a vector of strings, while the instructions will be stored in a union 
 // which will alternate storing a number of steps or new directions. The algorithm will move us across
 // the grid (= the map) step by step. For Part 1, wrapping around the map will be done by simpling 
@@ -24,51 +27,43 @@ void get_data(const std::string&, std::vector<std::string>&, std::vector<Instruc
 void solve_part_one(const std::vector<std::string>&, const std::vector<Instruction>&); 
 void solve_part_two(const std::vector<std::string>&, const std::vector<Instruction>&, bool); 
 
-int main(int argc, char* argv[]) {
-
-    std::cout << ">>> Advent Of Code 2022 - Day 22 <<<" << std::endl; 
-
-    std::string file_name; 
-    bool is_test = false; 
-    std::vector<std::string> grid;
-    std::vector<Instruction> instructions;  
-
-    
-    if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-    if (is_test) file_name = "./test.txt"; 
-    else file_name = "./input.txt"; 
+bool is_test = false; 
+std::vector<std::string> grid;
+std::vector<Instruction> instructions;  
 
+void load(const std::string& file_name, bool test) {
+    is_test = test; 
+    grid.clear(); 
+    instructions.clear(); 
     get_data(file_name, grid, instructions); 
+}
 
-    if (is_test) { 
-        for (const auto& line: grid) {
-            std::cout << line << std::endl; 
-        }
-        std::cout << ">>>>>>>>> INSTRUCTIONS: <<<<<<<<<<" << std::endl; 
-        for (size_t i = 0; i < instructions.size(); ++i) {
-            if (i % 2 == 0) std::cout << instructions.at(i).forward_steps;
-            else std::cout << instructions.at(i).direction; 
-            if (i < instructions.size() - 1) std::cout << " -> ";
-            else std::cout << std::endl;  
-        }
-    
+void print() {
+    for (const auto& line: grid) {
+        aoc::out() << line << std::endl; 
     }
+    aoc::out() << ">>>>>>>>> INSTRUCTIONS: <<<<<<<<<<" << std::endl; 
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (i % 2 == 0) aoc::out() << instructions.at(i).forward_steps;
+        else aoc::out() << instructions.at(i).direction; 
+        if (i < instructions.size() - 1) aoc::out() << " -> ";
+        else aoc::out() << std::endl;  
+    }
+}
 
-    solve_part_one(grid, instructions); 
-    solve_part_two(grid, instructions, is_test); 
+void part_one() { solve_part_one(grid, instructions); }
+void part_two() { solve_part_two(grid, instructions, is_test); }
 
-    return 0; 
-}
+extern const aoc::Day day{22, load, print, part_one, part_two}; 
 
 // Get the input data
 void get_data(const std::string& file_name, std::vector<std::string>& grid, std::vector<Instruction>& instructions) {
-    std::ifstream input_file{file_name}; 
+    aoc::InputFile input_file{file_name}; 
 
     if (input_file.is_open()) {
-        std::string line; 
         bool map_is_done = false; 
         bool is_direction = false; 
-        while (std::getline(input_file, line)) {
+        for (auto line: input_file.lines()) {
             
             if (line.empty()) {
                 map_is_done = true; 
@@ -77,23 +72,19 @@ void get_data(const std::string& file_name, std::vector<std::string>& grid, std:
 
             // Store the next map line 
             if (!map_is_done) {
-                grid.push_back(line); 
+                grid.emplace_back(line); 
                 continue; 
             }
 
             // Import instructions 
-            std::istringstream line_stream(line); 
-
-            while (line_stream.peek() != EOF) {
+            while (!line.empty()) {
                 Instruction instruction; 
                 if (!is_direction) {
-                    int n_steps; 
-                    line_stream >> n_steps; 
-                    instruction.forward_steps = n_steps; 
+                    instruction.forward_steps = aoc::parse_int<int>(line); 
                     is_direction = true; 
                 } else {
-                    char new_direction = line_stream.get(); 
-                    instruction.direction = new_direction; 
+                    instruction.direction = line.front(); 
+                    line.remove_prefix(1); 
                     is_direction = false; 
                 }
                 instructions.push_back(instruction); 
@@ -103,7 +94,6 @@ void get_data(const std::string& file_name, std::vector<std::string>& grid, std:
         std::cerr << "Could not open the file." << std::endl; 
         exit(0); 
     }
-    input_file.close(); 
 } 
 
 // Algorithms 
@@ -473,12 +463,18 @@ auto navigate_map(const std::vector<std::string>& grid, const std::vector<Instru
 
 void solve_part_one(const std::vector<std::string>& grid, const std::vector<Instruction>& instructions) {
     auto solution = navigate_map(grid, instructions);
-    std::cout << "The solution to part one is " << solution << std::endl; 
+    aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 void solve_part_two(const std::vector<std::string>& grid, const std::vector<Instruction>& instructions, bool is_test) {
     auto solution = navigate_map(grid, instructions, true, is_test);
-    std::cout << "The solution to part two is " << solution << std::endl; 
+    aoc::out() << "The solution to part two is " << solution << std::endl; 
 }
 
+} // namespace day22
 
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day22::day, argc, argv); 
+}
+#endif
@@ -1,6 +1,4 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -9,6 +7,11 @@
 #include <limits>
 #include <cmath>
 
+#include "day.h"
+#include "input.h"
+
+namespace day23 {
+
 /* For today's task, I will create and Elf struct (which really is a coordinate container) 
    that will implement the following methods: 
    - one that generate all neighboring Elves in the 8 surrounding directions
@@ -54,7 +57,7 @@ struct Elf {
   explicit Elf(long int r, long int c): row(r), col(c) {}
   
   auto print() const -> void {
-    std::cout << "(" << row << "," << col << ")" << std::endl; 
+    aoc::out() << "(" << row << "," << col << ")" << std::endl; 
   }
   
   // Gets all the Elf's neighbors 
@@ -127,43 +130,34 @@ void get_data(const std::string&, std::unordered_set<Elf, Elf::ElfHash>&);
 void solve_part_one(std::unordered_set<Elf, Elf::ElfHash>); 
 void solve_part_two(std::unordered_set<Elf, Elf::ElfHash>); 
 
-int main(int argc, char* argv[]) {
-  
-  std::cout << ">>> Advent Of Code 2022 - Day 23 <<<" << std::endl; 
-  
-  std::string file_name; 
-  bool is_test = false; 
-  std::unordered_set<Elf, Elf::ElfHash> elves;
-  
-  if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-  if (is_test) file_name = "./test.txt"; 
-  else file_name = "./input.txt"; 
-  
+std::unordered_set<Elf, Elf::ElfHash> elves;
+
+void load(const std::string& file_name, bool) {
+  elves.clear(); 
   get_data(file_name, elves); 
-  
-  if (is_test) {
-    std::cout << "Elves: " << std::endl; 
-    for (const auto& e: elves) e.print(); 
-  }
-  
-  solve_part_one(elves); 
-  solve_part_two(elves); 
-      
-  return 0; 
 }
 
+void print() {
+  aoc::out() << "Elves: " << std::endl; 
+  for (const auto& e: elves) e.print(); 
+}
+
+void part_one() { solve_part_one(elves); }
+void part_two() { solve_part_two(elves); }
+
+extern const aoc::Day day{23, load, print, part_one, part_two}; 
+
 
 // Get the input data
 void get_data(const std::string& file_name, std::unordered_set<Elf, Elf::ElfHash>& elves) {
   
-  std::ifstream input_file{file_name}; 
+  aoc::InputFile input_file{file_name}; 
   
   if (input_file.is_open()) {
-    std::string line; 
     long int row_counter = 0; 
-    while (std::getline(input_file, line)) {
+    for (auto line: input_file.lines()) {
       for (long int col_counter = 0; col_counter < line.size(); ++col_counter) {
-        if (line.at(col_counter) == '#') {
+        if (line[col_counter] == '#') {
           Elf elf(row_counter, col_counter);
           elves.insert(elf); 
         }
@@ -174,7 +168,6 @@ void get_data(const std::string& file_name, std::unordered_set<Elf, Elf::ElfHash
     std::cerr << "Could not open the file." << std::endl; 
     exit(0); 
   }
-  input_file.close(); 
 } 
 
 // Algorithms
@@ -256,10 +249,18 @@ auto move_elves(std::unordered_set<Elf, Elf::ElfHash>& elves, bool part_two = fa
   
 void solve_part_one(std::unordered_set<Elf, Elf::ElfHash> elves) {
   auto solution = move_elves(elves);
-  std::cout << "The solution to part one is " << solution << std::endl; 
+  aoc::out() << "The solution to part one is " << solution << std::endl; 
 }
 
 void solve_part_two(std::unordered_set<Elf, Elf::ElfHash> elves) {
   auto solution = move_elves(elves, true);
-  std::cout << "The solution to part two is " << solution << std::endl; 
+  aoc::out() << "The solution to part two is " << solution << std::endl; 
+}
+
+} // namespace day23
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day23::day, argc, argv); 
 }
+#endif
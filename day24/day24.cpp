@@ -1,6 +1,4 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -10,6 +8,11 @@
 #include <set>
 #include <cmath>
 
+#include "day.h"
+#include "input.h"
+
+namespace day24 {
+
 /* This is a faster implementation w.r.t. the original one that can be found in the original version of the day 
  * (included in this folder). As proposed in the introduction of that file, instead of checking all the potential 
  * blizzard moves across the cyclic time span, we keep the blizzards fixed in their original positions. What I'll do is 
@@ -130,47 +133,36 @@ void get_data(const std::string&, std::vector<std::string>&);
 void solve_part_one(const std::vector<std::string>&); 
 void solve_part_two(const std::vector<std::string>&);
 
-int main(int argc, char* argv[]) {
-  
-  std::cout << ">>> Advent Of Code 2022 - Day 24 <<<" << std::endl; 
-  
-  std::string file_name; 
-  bool is_test = false; 
-  std::vector<std::string> map; 
-  
-  if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-  if (is_test) file_name = "./test.txt"; 
-  else file_name = "./input.txt"; 
-  
+std::vector<std::string> map; 
+
+void load(const std::string& file_name, bool) {
+  map.clear(); 
   get_data(file_name, map); 
-  
-  if (is_test) {
-    for (const auto& map_line: map) std::cout << map_line << std::endl; 
-  }
-  
-  solve_part_one(map);
-  solve_part_two(map); 
-      
-  return 0; 
 }
 
+void print() {
+  for (const auto& map_line: map) aoc::out() << map_line << std::endl; 
+}
+
+void part_one() { solve_part_one(map); }
+void part_two() { solve_part_two(map); }
+
+extern const aoc::Day day{24, load, print, part_one, part_two}; 
+
 
 // Get the input data
 void get_data(const std::string& file_name, std::vector<std::string>& map) {
   
-  std::ifstream input_file{file_name}; 
+  aoc::InputFile input_file{file_name}; 
   
   if (input_file.is_open()) {
-    std::string line; 
-    long int row_counter = 0; 
-    while (std::getline(input_file, line)) {
-      map.push_back(line); 
+    for (auto line: input_file.lines()) {
+      map.emplace_back(line); 
     }
   } else {
     std::cerr << "Could not open the file." << std::endl; 
     exit(0); 
   }
-  input_file.close(); 
 } 
 
 // Algorithms
@@ -212,7 +204,7 @@ auto shortest_path(const std::vector<std::string>& map, const Coordinate& start_
     auto new_state_it = priority_queue.begin(); 
     
     if (new_state_it->first == end_to) return new_state_it->second; 
-    // std::cout << new_state_it->first.to_string() << " -> " << new_state_it->second << std::endl; 
+    // aoc::out() << new_state_it->first.to_string() << " -> " << new_state_it->second << std::endl; 
     auto curr_pos = new_state_it->first; 
     auto curr_time = new_state_it->second + 1; 
     priority_queue.erase(new_state_it); // remove the coordinate from the priority queue 
@@ -254,10 +246,18 @@ auto find_exit(const std::vector<std::string>& map, bool part_two = false) -> in
 
 void solve_part_one(const std::vector<std::string>& map) {
   auto solution = find_exit(map);
-  std::cout << "The solution to part one is " << solution << std::endl;
+  aoc::out() << "The solution to part one is " << solution << std::endl;
 }
 
 void solve_part_two(const std::vector<std::string>& map) {
   auto solution = find_exit(map, true);
-  std::cout << "The solution to part two is " << solution << std::endl;
+  aoc::out() << "The solution to part two is " << solution << std::endl;
+}
+
+} // namespace day24
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day24::day, argc, argv); 
 }
+#endif
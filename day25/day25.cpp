@@ -1,9 +1,12 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
 
+#include "day.h"
+#include "input.h"
+
+namespace day25 {
+
 /* Finally, the last day of AoC 2022! In today's puzzle we are required to transform  
  * some SNAFU number into decimal, perform their sum, and return the sum converted back to SNAFU.
  * SNAFU is a sort of base-5 numbering which allows for negative (-2 and -1) digits, and therefore it 
@@ -26,46 +29,36 @@ void get_data(const std::string&, std::vector<std::string>&);
 void solve_part_one(const std::vector<std::string>&); 
 void solve_part_two(); 
 
-int main(int argc, char* argv[]) {
-  
-  std::cout << ">>> Advent Of Code 2022 - Day 25 <<<" << std::endl; 
-  
-  std::string file_name; 
-  bool is_test = false; 
-  std::vector<std::string> snafu_numbers;
-  
-  if (argc > 1 && std::string(argv[1]) == "test") is_test = true; 
-  if (is_test) file_name = "./test.txt"; 
-  else file_name = "./input.txt"; 
-  
+std::vector<std::string> snafu_numbers;
+
+void load(const std::string& file_name, bool) {
+  snafu_numbers.clear(); 
   get_data(file_name, snafu_numbers); 
-  
-  if (is_test) {
-    for (const auto& n: snafu_numbers) std::cout << n << std::endl; 
-  }
-  
-  solve_part_one(snafu_numbers); 
-  solve_part_two(); 
-  
-  return 0; 
 }
 
+void print() {
+  for (const auto& n: snafu_numbers) aoc::out() << n << std::endl; 
+}
+
+void part_one() { solve_part_one(snafu_numbers); }
+void part_two() { solve_part_two(); }
+
+extern const aoc::Day day{25, load, print, part_one, part_two}; 
+
 
 // Get the input data
 void get_data(const std::string& file_name, std::vector<std::string>& snafu_numbers) {
   
-  std::ifstream input_file{file_name}; 
+  aoc::InputFile input_file{file_name}; 
   
   if (input_file.is_open()) {
-    std::string line; 
-    while (std::getline(input_file, line)) {
-      snafu_numbers.push_back(line); 
+    for (auto line: input_file.lines()) {
+      snafu_numbers.emplace_back(line); 
     }
   } else {
     std::cerr << "Could not open the file." << std::endl; 
     exit(0); 
   }
-  input_file.close(); 
 } 
 
 // Algorithms
@@ -132,9 +125,17 @@ auto convert_and_sum(const std::vector<std::string>& snafu_numbers) -> std::stri
 
 void solve_part_one(const std::vector<std::string>& snafu_numbers) {
   auto solution = convert_and_sum(snafu_numbers);
-  std::cout << "The solution to part one is " << solution << std::endl;
+  aoc::out() << "The solution to part one is " << solution << std::endl;
 }
 
 void solve_part_two() {
-  std::cout << "             >>>>> The end <<<<<" << std::endl;
+  aoc::out() << "             >>>>> The end <<<<<" << std::endl;
+}
+
+} // namespace day25
+
+#ifndef AOC2022_RUNNER
+int main(int argc, char* argv[]) {
+    return aoc::run_day(day25::day, argc, argv); 
 }
+#endif
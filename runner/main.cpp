@@ -0,0 +1,134 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+
+#include "day.h"
+#include "input.h"
+#include "registry.h"
+#include "thread_pool.h"
+
+// Runs any selection of days (and parts) in a single process. The days are independent of each other,
+// so they are scheduled on a pool of worker threads; each day writes its output into its own buffer,
+// and the buffers are printed in day order as soon as they are complete. The printed output is the
+// same as the one of the standalone dayNN executables run one after the other.
+
+struct Options {
+    bool is_test = false; 
+    bool show_help = false; 
+    bool run_part_one = true; 
+    bool run_part_two = true; 
+    size_t n_jobs = aoc::default_concurrency(); 
+    std::string input_dir = AOC2022_INPUT_DIR; 
+    std::vector<const aoc::Day*> days; 
+}; 
+
+void print_usage(std::ostream& os) {
+    os << "Usage: aoc2022 [--help] [test] [--part 1|2] [--jobs N] [--input-dir DIR] [DAY | FIRST-LAST ...]\n"
+          "  --help, -h       print this message\n"
+          "  test             run the test cases (dayNN/test.txt) instead of the puzzle inputs\n"
+          "  --part 1|2       only run the given part\n"
+          "  --jobs N         number of days to run concurrently (default: number of cores)\n"
+          "  --input-dir DIR  directory containing the dayNN/ input directories\n"
+          "  DAY, FIRST-LAST  days to run (default: all the days)\n"
+          "The options of the days (e.g. --top K for day 1, --scan for day 15) are passed on to them." << std::endl; 
+}
+
+bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]); 
+        bool has_value = i + 1 < argc; 
+
+        if (arg == "--help" || arg == "-h") {
+            options.show_help = true; 
+        } else if (arg == "test") {
+            options.is_test = true; 
+        } else if (arg == "--part" && has_value) {
+            std::string part(argv[++i]); 
+            if (part != "1" && part != "2") return false; 
+            options.run_part_one = part == "1"; 
+            options.run_part_two = part == "2"; 
+        } else if (arg == "--jobs" && has_value) {
+            options.n_jobs = aoc::to_int<size_t>(argv[++i]); 
+            if (options.n_jobs == 0) return false; 
+        } else if (arg == "--input-dir" && has_value) {
+            options.input_dir = argv[++i]; 
+        } else if (!aoc::select_days(arg, options.days)) {
+            return false; 
+        }
+    }
+
+    if (options.days.empty()) options.days = aoc::all_days(); 
+    return true; 
+}
+
+// Runs the selected parts of a day, writing everything into the output buffer
+void run_day(const aoc::Day& day, const Options& options, std::ostringstream& output) {
+    aoc::redirect_output(output); 
+    aoc::print_header(day); 
+
+    auto file_name = aoc::input_file_name(options.input_dir, day, options.is_test); 
+    // The days terminate the process if their input is missing, so it is checked beforehand
+    if (!aoc::InputFile(file_name).is_open()) {
+        output << "Could not open the file " << file_name << std::endl; 
+        return; 
+    }
+
+    try {
+        day.load(file_name, options.is_test); 
+        if (options.is_test) day.print(); 
+        if (options.run_part_one) day.part_one(); 
+        if (options.run_part_two) day.part_two(); 
+    } catch (const std::exception& e) {
+        output << "Day " << day.number << " failed: " << e.what() << std::endl; 
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    // The options of the days are taken out of the command line first, whichever days are selected 
+    for (const auto* day: aoc::all_days()) aoc::take_day_options(*day, argc, argv); 
+
+    Options options; 
+    if (!parse_options(argc, argv, options)) {
+        print_usage(std::cerr); 
+        return 1; 
+    }
+    if (options.show_help) {
+        print_usage(std::cout); 
+        return 0; 
+    }
+
+    auto n_days = options.days.size(); 
+    std::vector<std::ostringstream> outputs(n_days); 
+    std::vector<bool> is_done(n_days, false); 
+    std::mutex done_mutex; 
+    std::condition_variable done_condition; 
+
+    std::thread scheduler([&]() {
+        aoc::parallel_for(n_days, [&](size_t i) {
+            run_day(*options.days.at(i), options, outputs.at(i)); 
+            {
+                std::lock_guard<std::mutex> lock(done_mutex); 
+                is_done.at(i) = true; 
+            }
+            done_condition.notify_one(); 
+        }, options.n_jobs); 
+    }); 
+
+    // Print the days in order, each one as soon as it (and all the previous ones) are done
+    for (size_t i = 0; i < n_days; ++i) {
+        {
+            std::unique_lock<std::mutex> lock(done_mutex); 
+            done_condition.wait(lock, [&]() { return is_done.at(i); }); 
+        }
+        std::cout << outputs.at(i).str() << std::flush; 
+    }
+
+    scheduler.join(); 
+    return 0; 
+}
@@ -0,0 +1,77 @@
+#include "registry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string_view>
+
+#include "input.h"
+
+namespace day01 { extern const aoc::Day day; }
+namespace day02 { extern const aoc::Day day; }
+namespace day03 { extern const aoc::Day day; }
+namespace day04 { extern const aoc::Day day; }
+namespace day05 { extern const aoc::Day day; }
+namespace day06 { extern const aoc::Day day; }
+namespace day07 { extern const aoc::Day day; }
+namespace day08 { extern const aoc::Day day; }
+namespace day09 { extern const aoc::Day day; }
+namespace day10 { extern const aoc::Day day; }
+namespace day11 { extern const aoc::Day day; }
+namespace day12 { extern const aoc::Day day; }
+namespace day13 { extern const aoc::Day day; }
+namespace day14 { extern const aoc::Day day; }
+namespace day15 { extern const aoc::Day day; }
+namespace day16 { extern const aoc::Day day; }
+namespace day17 { extern const aoc::Day day; }
+namespace day18 { extern const aoc::Day day; }
+namespace day19 { extern const aoc::Day day; }
+namespace day20 { extern const aoc::Day day; }
+namespace day21 { extern const aoc::Day day; }
+namespace day22 { extern const aoc::Day day; }
+namespace day23 { extern const aoc::Day day; }
+namespace day24 { extern const aoc::Day day; }
+namespace day25 { extern const aoc::Day day; }
+
+namespace aoc {
+
+const std::vector<const Day*>& all_days() {
+    static const std::vector<const Day*> days{
+        &day01::day, &day02::day, &day03::day, &day04::day, &day05::day,
+        &day06::day, &day07::day, &day08::day, &day09::day, &day10::day,
+        &day11::day, &day12::day, &day13::day, &day14::day, &day15::day,
+        &day16::day, &day17::day, &day18::day, &day19::day, &day20::day,
+        &day21::day, &day22::day, &day23::day, &day24::day, &day25::day
+    }; 
+    return days; 
+}
+
+const Day* find_day(int number) {
+    for (auto day: all_days()) {
+        if (day->number == number) return day; 
+    }
+    return nullptr; 
+}
+
+bool select_days(const std::string& arg, std::vector<const Day*>& days) {
+    std::string_view text(arg); 
+    auto first = parse_int<int>(text); 
+    auto last = first; 
+    if (skip_prefix(text, "-")) last = parse_int<int>(text); 
+    if (!text.empty() || first > last) return false; 
+
+    for (int number = first; number <= last; ++number) {
+        auto day = find_day(number); 
+        if (!day) return false; 
+        // A day keeps its data in its own namespace, so it must not run twice at the same time 
+        if (std::find(days.begin(), days.end(), day) == days.end()) days.push_back(day); 
+    }
+    return true; 
+}
+
+std::string input_file_name(const std::string& input_dir, const Day& day, bool is_test) {
+    char directory[8]; 
+    std::snprintf(directory, sizeof(directory), "day%02d", day.number); 
+    return input_dir + "/" + directory + (is_test ? "/test.txt" : "/input.txt"); 
+}
+
+} // namespace aoc
@@ -0,0 +1,26 @@
+#ifndef AOC2022_RUNNER_REGISTRY_H
+#define AOC2022_RUNNER_REGISTRY_H
+
+#include <string>
+#include <vector>
+
+#include "day.h"
+
+namespace aoc {
+
+// All the days, sorted by day number 
+const std::vector<const Day*>& all_days(); 
+
+// Returns the day with the given number, or nullptr if there is no such day 
+const Day* find_day(int number); 
+
+// Parses a day ("16") or a range of days ("1-10") and adds them to the selection (skipping the days 
+// that are already selected). Returns false if the argument does not name existing days. 
+bool select_days(const std::string& arg, std::vector<const Day*>& days); 
+
+// Path of a day's input (or test) file, as found in the day's directory under input_dir 
+std::string input_file_name(const std::string& input_dir, const Day& day, bool is_test); 
+
+} // namespace aoc
+
+#endif